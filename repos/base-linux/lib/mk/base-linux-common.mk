@@ -12,3 +12,4 @@ SRC_CC += region_map_mmap.cc debug.cc
 SRC_CC += rpc_dispatch_loop.cc
 SRC_CC += thread_env.cc
 SRC_CC += capability.cc
+SRC_CC += signal_transmitter.cc
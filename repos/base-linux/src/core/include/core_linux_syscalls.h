@@ -20,6 +20,7 @@
 #define size_t __SIZE_TYPE__ /* see comment in 'linux_syscalls.h' */
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <poll.h>
 #undef size_t
 
 
@@ -194,4 +195,14 @@ inline int lx_read(int fd, void *buf, Genode::size_t count)
 }
 
 
+/*************************************************
+ ** Retry of signal delivery to congested peers **
+ *************************************************/
+
+inline int lx_poll(struct pollfd *fds, unsigned long nfds, int timeout_ms)
+{
+	return lx_syscall(SYS_poll, fds, nfds, timeout_ms);
+}
+
+
 #endif /* _CORE__INCLUDE__CORE_LINUX_SYSCALLS_H_ */
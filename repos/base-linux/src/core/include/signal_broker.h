@@ -0,0 +1,249 @@
+/*
+ * \brief  Linux-specific signal-delivery mechanism
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * On Linux, signals are delivered directly from the transmitter to the
+ * socket of the receiving signal-handler thread, bypassing core. Core
+ * allocates the signal contexts and thereby accounts them to the receiving
+ * PD. The capability of a signal context refers to the socket registered by
+ * the signal source and carries the imprint of the context as badge.
+ *
+ * Core never blocks on the socket of a receiver. If the receiver is
+ * congested, core accumulates the signals in the counter of the context.
+ * The retry thread delivers them once the receiver's socket becomes
+ * writeable.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CORE__INCLUDE__SIGNAL_BROKER_H_
+#define _CORE__INCLUDE__SIGNAL_BROKER_H_
+
+/* core-local includes */
+#include <signal_source_component.h>
+#include <signal_source/capability.h>
+#include <signal_context_slab.h>
+#include <signal_retry.h>
+
+/* base-internal includes */
+#include <base/internal/signal_datagram.h>
+
+namespace Genode { class Signal_broker; }
+
+
+class Genode::Signal_broker : private Signal_retry::Client
+{
+	private:
+
+		Allocator                   &_md_alloc;
+		Rpc_entrypoint              &_source_ep;
+		Object_pool<Rpc_object_base> _contexts { };
+		Signal_source_component      _source;
+		Signal_source_capability     _source_cap;
+		Signal_context_slab          _context_slab { _md_alloc };
+
+		/*
+		 * Contexts with signals pending because of a congested receiver
+		 */
+		Lock         _congested_lock { };
+		Signal_queue _congested      { };
+
+		/**
+		 * Retry the delivery of pending signals, the caller must hold
+		 * '_congested_lock'
+		 *
+		 * All contexts of the broker refer to the same receiver. Hence,
+		 * the retry stops at the first context that is still congested.
+		 */
+		void _flush_congested()
+		{
+			while (Signal_context_component *context = _congested.head()) {
+
+				Signal_datagram_result const result =
+					send_signal_datagram(context->cap(), context->cnt());
+
+				if (result == SIGNAL_CONGESTED)
+					return;
+
+				if (result == SIGNAL_UNDELIVERABLE)
+					warning("unable to deliver pending signals to ", context->cap());
+
+				_congested.dequeue();
+				context->reset_signal_cnt();
+			}
+		}
+
+		/**
+		 * Deliver signal or keep it pending, the caller must hold
+		 * '_congested_lock'
+		 */
+		void _submit(Signal_context_capability const cap, unsigned const cnt)
+		{
+			_flush_congested();
+
+			_contexts.apply(cap, [&] (Signal_context_component *context) {
+
+				if (!context) {
+					warning("specified signal-context capability has wrong type");
+					return;
+				}
+
+				/* keep the order of signals behind pending ones */
+				if (context->enqueued()) {
+					context->increment_signal_cnt(cnt);
+					return;
+				}
+
+				switch (send_signal_datagram(cap, cnt)) {
+
+				case SIGNAL_DELIVERED:
+					return;
+
+				case SIGNAL_CONGESTED:
+					context->increment_signal_cnt(cnt);
+					_congested.enqueue(context);
+					return;
+
+				case SIGNAL_UNDELIVERABLE:
+					warning("unable to deliver signal to ", cap);
+					return;
+				}
+			});
+		}
+
+
+		/************************************
+		 ** Signal_retry::Client interface **
+		 ************************************/
+
+		int congested_socket() override
+		{
+			Lock::Guard guard(_congested_lock);
+
+			Signal_context_component const *context = _congested.head();
+
+			return context ? Capability_space::ipc_cap_data(context->cap()).dst.socket
+			               : -1;
+		}
+
+		void flush() override
+		{
+			Lock::Guard guard(_congested_lock);
+			_flush_congested();
+		}
+
+	public:
+
+		class Invalid_signal_source : public Exception { };
+
+		Signal_broker(Allocator      &md_alloc,
+		              Rpc_entrypoint &source_ep,
+		              Rpc_entrypoint &context_ep)
+		:
+			_md_alloc(md_alloc),
+			_source_ep(source_ep),
+			_source(&context_ep),
+			_source_cap(_source_ep.manage(&_source))
+		{ }
+
+		~Signal_broker()
+		{
+			signal_retry().remove(*this);
+
+			/* remove source from entrypoint */
+			_source_ep.dissolve(&_source);
+
+			/* free all signal contexts */
+			while (Signal_context_component *r = _context_slab.any_signal_context())
+				free_context(reinterpret_cap_cast<Signal_context>(r->cap()));
+		}
+
+		Signal_source_capability alloc_signal_source() { return _source_cap; }
+
+		void free_signal_source(Signal_source_capability) { }
+
+		/*
+		 * \throw Allocator::Out_of_memory
+		 */
+		Signal_context_capability
+		alloc_context(Signal_source_capability, unsigned long imprint)
+		{
+			/*
+			 * XXX  For now, we ignore the signal-source argument as we
+			 *      create only a single receiver for each PD.
+			 */
+
+			Native_capability const receiver = _source.receiver();
+
+			if (!receiver.valid()) {
+				warning("signal source lacks a registered receiver");
+				return Signal_context_capability();
+			}
+
+			Native_capability const cap = Capability_space::import(
+				Capability_space::ipc_cap_data(receiver).dst, Rpc_obj_key(imprint));
+
+			/* the _context_slab may throw Allocator::Out_of_memory */
+			Signal_context_component *context = new (&_context_slab)
+				Signal_context_component(imprint, &_source);
+
+			static_cast<Rpc_object_base &>(*context).cap(cap);
+			_contexts.insert(context);
+
+			return reinterpret_cap_cast<Signal_context>(cap);
+		}
+
+		void free_context(Signal_context_capability context_cap)
+		{
+			Signal_context_component *context = nullptr;
+
+			_contexts.apply(context_cap, [&] (Signal_context_component *c) {
+
+				if (!c) {
+					warning("specified signal-context capability has wrong type");
+					return;
+				}
+
+				context = c;
+				_contexts.remove(context);
+			});
+
+			if (!context)
+				return;
+
+			{
+				Lock::Guard guard(_congested_lock);
+				_congested.remove(context);
+			}
+
+			destroy(&_context_slab, context);
+		}
+
+		/**
+		 * Deliver signal on behalf of a transmitter
+		 *
+		 * Transmitters resort to this path only if they cannot deliver the
+		 * signal by themselves, e.g., if they lack a socket to the receiver.
+		 * Signals of a context stay in order because signals submitted while
+		 * the context is pending are accumulated in its counter.
+		 */
+		void submit(Signal_context_capability const cap, unsigned const cnt)
+		{
+			{
+				Lock::Guard guard(_congested_lock);
+				_submit(cap, cnt);
+			}
+
+			/* let the retry thread deliver the pending signals */
+			if (congested_socket() >= 0)
+				signal_retry().wake_up(*this);
+		}
+};
+
+#endif /* _CORE__INCLUDE__SIGNAL_BROKER_H_ */
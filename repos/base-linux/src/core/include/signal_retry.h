@@ -0,0 +1,105 @@
+/*
+ * \brief  Retry of signal deliveries to congested receivers
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CORE__INCLUDE__SIGNAL_RETRY_H_
+#define _CORE__INCLUDE__SIGNAL_RETRY_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <util/list.h>
+#include <util/interface.h>
+
+namespace Genode {
+
+	class Signal_retry;
+
+	/**
+	 * Return singleton instance of the retry thread
+	 */
+	Signal_retry &signal_retry();
+}
+
+
+/**
+ * Core thread that delivers the signals kept pending for congested receivers
+ *
+ * A client, i.e., a signal broker, registers at the thread once the receiver
+ * of its signals is congested. The thread waits until the socket of one of
+ * the receivers becomes writeable and lets all clients retry the delivery.
+ * A client stays registered until no signals are pending anymore.
+ */
+class Genode::Signal_retry : public Thread_deprecated<4096>
+{
+	public:
+
+		struct Client : List<Client>::Element, Interface
+		{
+			/* protected by the lock of the retry thread */
+			bool registered = false;
+
+			/**
+			 * Return socket of the congested receiver
+			 *
+			 * \return -1 if no signals are pending
+			 */
+			virtual int congested_socket() = 0;
+
+			/**
+			 * Retry the delivery of the pending signals
+			 */
+			virtual void flush() = 0;
+		};
+
+	private:
+
+		/*
+		 * Number of sockets polled at once and the poll timeout, which
+		 * covers the receivers beyond 'MAX_POLLED'
+		 */
+		enum { MAX_POLLED = 64, TIMEOUT_MS = 10 };
+
+		Lock         _lock    { };
+		List<Client> _clients { };
+		Semaphore    _wakeup  { };
+
+		/**
+		 * Wait for a writeable receiver and let all clients flush
+		 *
+		 * \return true if clients with pending signals remain
+		 */
+		bool _retry();
+
+		void entry() override;
+
+	public:
+
+		Signal_retry() : Thread_deprecated<4096>("signal_retry") { start(); }
+
+		/**
+		 * Register client with pending signals
+		 *
+		 * The caller must not hold a lock that is acquired by the client's
+		 * 'congested_socket' or 'flush' methods.
+		 */
+		void wake_up(Client &);
+
+		/**
+		 * Unregister client
+		 *
+		 * After returning, the retry thread no longer accesses the client.
+		 */
+		void remove(Client &);
+};
+
+#endif /* _CORE__INCLUDE__SIGNAL_RETRY_H_ */
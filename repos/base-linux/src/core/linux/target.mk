@@ -24,7 +24,8 @@ SRC_CC        = main.cc \
                 core_rpc_cap_alloc.cc \
                 io_mem_session_component.cc \
                 signal_source_component.cc \
-                signal_transmitter_proxy.cc \
+                signal_retry.cc \
+                signal_transmitter_noinit.cc \
                 signal_receiver.cc \
                 trace_session_component.cc \
                 thread_linux.cc \
@@ -60,7 +61,7 @@ vpath rpc_cap_factory_l4.cc       $(GEN_CORE_DIR)
 vpath ram_dataspace_factory.cc    $(GEN_CORE_DIR)
 vpath platform_services.cc        $(GEN_CORE_DIR)
 vpath signal_source_component.cc  $(GEN_CORE_DIR)
-vpath signal_transmitter_proxy.cc $(GEN_CORE_DIR)
+vpath signal_transmitter_noinit.cc $(GEN_CORE_DIR)
 vpath signal_receiver.cc          $(GEN_CORE_DIR)
 vpath trace_session_component.cc  $(GEN_CORE_DIR)
 vpath core_rpc_cap_alloc.cc       $(GEN_CORE_DIR)
@@ -0,0 +1,108 @@
+/*
+ * \brief  Retry of signal deliveries to congested receivers
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* core-local includes */
+#include <signal_retry.h>
+#include <core_linux_syscalls.h>
+
+using namespace Genode;
+
+
+Signal_retry &Genode::signal_retry()
+{
+	static Signal_retry inst;
+	return inst;
+}
+
+
+void Signal_retry::wake_up(Client &client)
+{
+	Lock::Guard guard(_lock);
+
+	if (client.registered)
+		return;
+
+	client.registered = true;
+	_clients.insert(&client);
+	_wakeup.up();
+}
+
+
+void Signal_retry::remove(Client &client)
+{
+	Lock::Guard guard(_lock);
+
+	if (!client.registered)
+		return;
+
+	client.registered = false;
+	_clients.remove(&client);
+}
+
+
+bool Signal_retry::_retry()
+{
+	pollfd   fds[MAX_POLLED];
+	unsigned num_fds = 0;
+
+	{
+		Lock::Guard guard(_lock);
+
+		for (Client *c = _clients.first(); c && num_fds < MAX_POLLED; c = c->next()) {
+
+			int const sd = c->congested_socket();
+			if (sd < 0)
+				continue;
+
+			fds[num_fds].fd      = sd;
+			fds[num_fds].events  = POLLOUT;
+			fds[num_fds].revents = 0;
+			num_fds++;
+		}
+	}
+
+	/*
+	 * A socket may get closed and reused in the meantime. This merely
+	 * results in a premature or delayed retry.
+	 */
+	if (num_fds)
+		lx_poll(fds, num_fds, TIMEOUT_MS);
+
+	Lock::Guard guard(_lock);
+
+	for (Client *c = _clients.first(), *next = nullptr; c; c = next) {
+
+		next = c->next();
+
+		c->flush();
+
+		if (c->congested_socket() < 0) {
+			c->registered = false;
+			_clients.remove(c);
+		}
+	}
+
+	return _clients.first() != nullptr;
+}
+
+
+void Signal_retry::entry()
+{
+	for (;;) {
+
+		/* block until a client with pending signals registers */
+		_wakeup.down();
+
+		while (_retry());
+	}
+}
@@ -43,7 +43,7 @@ class Stack_area_region_map : public Genode::Region_map
 		 * Attach backing store to stack area
 		 */
 		Local_addr attach(Genode::Dataspace_capability, Genode::size_t size,
-		                  Genode::off_t, bool, Local_addr local_addr, bool)
+		                  Genode::off_t, bool, Local_addr local_addr, bool, bool)
 		{
 			using namespace Genode;
 
@@ -57,6 +57,11 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		 */
 		addr_t _base;
 
+		/**
+		 * True if the sub RM session is attached writeable
+		 */
+		bool _base_writeable = true;
+
 		bool _is_attached() const { return _base > 0; }
 
 		void _add_to_rmap(Region const &);
@@ -77,6 +82,7 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		                 bool                 use_local_addr,
 		                 addr_t               local_addr,
 		                 bool                 executable,
+		                 bool                 writeable,
 		                 bool                 overmap = false);
 
 		/**
@@ -116,7 +122,8 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 		 **************************/
 
 		Local_addr attach(Dataspace_capability ds, size_t size,
-		                  off_t, bool, Local_addr, bool executable);
+		                  off_t, bool, Local_addr, bool executable,
+		                  bool writeable);
 
 		void detach(Local_addr local_addr);
 
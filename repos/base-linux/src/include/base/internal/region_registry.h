@@ -31,6 +31,7 @@ class Genode::Region
 		off_t                _offset { 0 };
 		Dataspace_capability _ds     {   };
 		size_t               _size   { 0 };
+		bool                 _writeable { false };
 
 		/**
 		 * Return offset of first byte after the region
@@ -41,14 +42,19 @@ class Genode::Region
 
 		Region() { }
 
-		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size)
-		: _start(start), _offset(offset), _ds(ds), _size(size) { }
+		Region(addr_t start, off_t offset, Dataspace_capability ds, size_t size,
+		       bool writeable)
+		:
+			_start(start), _offset(offset), _ds(ds), _size(size),
+			_writeable(writeable)
+		{ }
 
 		bool                 used()      const { return _size > 0; }
 		addr_t               start()     const { return _start; }
 		off_t                offset()    const { return _offset; }
 		size_t               size()      const { return _size; }
 		Dataspace_capability dataspace() const { return _ds; }
+		bool                 writeable() const { return _writeable; }
 
 		bool intersects(Region const &r) const
 		{
@@ -0,0 +1,107 @@
+/*
+ * \brief  Linux-specific delivery of signals via Unix-domain sockets
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * A signal-context capability refers to the socket of the signal-handler
+ * thread of the receiving component. Its badge is the imprint of the signal
+ * context. A transmitter submits a signal by sending a datagram with the
+ * imprint and the number of signals to the socket.
+ *
+ * By default, the datagram is sent without blocking. If the socket queue of
+ * the receiver is full, the sender is told so. Core, in particular, must
+ * never block on a slow receiver.
+ *
+ * The delivery does not involve core. As with any other capability on Linux,
+ * the mechanism relies on the integrity of the involved processes. A
+ * component that holds a signal-context capability is able to send signals
+ * with any imprint to the receiver. The receiver validates imprints against
+ * its registry of live signal contexts.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__SIGNAL_DATAGRAM_H_
+#define _INCLUDE__BASE__INTERNAL__SIGNAL_DATAGRAM_H_
+
+/* base-internal includes */
+#include <base/internal/capability_space_tpl.h>
+
+/* Linux syscall bindings */
+#include <linux_syscalls.h>
+
+namespace Genode {
+
+	struct Signal_datagram
+	{
+		unsigned long imprint;
+		unsigned long num;
+	};
+
+	enum Signal_datagram_result { SIGNAL_DELIVERED,
+	                              SIGNAL_CONGESTED,
+	                              SIGNAL_UNDELIVERABLE };
+
+	/**
+	 * Send signal to the receiver referred to by 'context'
+	 *
+	 * \param block  wait until the receiver's socket queue has room
+	 *
+	 * \return 'SIGNAL_CONGESTED' if the socket queue of the receiver is
+	 *         full, or 'SIGNAL_UNDELIVERABLE' if the datagram could not be
+	 *         sent for another reason
+	 */
+	static inline Signal_datagram_result
+	send_signal_datagram(Native_capability const &context, unsigned cnt,
+	                     bool block = false)
+	{
+		enum { LX_EINTR = 4, LX_EAGAIN = 11 };
+
+		Capability_space::Ipc_cap_data const cap_data =
+			Capability_space::ipc_cap_data(context);
+
+		if (cap_data.dst.socket < 0 || !cap_data.rpc_obj_key.valid())
+			return SIGNAL_UNDELIVERABLE;
+
+		Signal_datagram datagram { cap_data.rpc_obj_key.value(), cnt };
+
+		iovec iov { &datagram, sizeof(datagram) };
+
+		msghdr msg { };
+		msg.msg_iov    = &iov;
+		msg.msg_iovlen = 1;
+
+		int ret = 0;
+		do { ret = lx_sendmsg(cap_data.dst.socket, &msg, block ? 0 : MSG_DONTWAIT); }
+		while (ret == -LX_EINTR);
+
+		if (ret == (int)sizeof(datagram))
+			return SIGNAL_DELIVERED;
+
+		return (ret == -LX_EAGAIN) ? SIGNAL_CONGESTED : SIGNAL_UNDELIVERABLE;
+	}
+
+	/**
+	 * Block until a signal datagram arrives at socket 'sd'
+	 *
+	 * \return false if the received message is not a signal datagram
+	 */
+	static inline bool receive_signal_datagram(int sd, Signal_datagram &datagram)
+	{
+		iovec iov { &datagram, sizeof(datagram) };
+
+		msghdr msg { };
+		msg.msg_iov    = &iov;
+		msg.msg_iovlen = 1;
+
+		return lx_recvmsg(sd, &msg, 0) == (int)sizeof(datagram)
+		    && !(msg.msg_flags & MSG_TRUNC);
+	}
+}
+
+#endif /* _INCLUDE__BASE__INTERNAL__SIGNAL_DATAGRAM_H_ */
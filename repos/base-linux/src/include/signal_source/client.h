@@ -0,0 +1,62 @@
+/*
+ * \brief  Linux-specific signal-source client interface
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * On Linux, signals are not fetched from core. Instead, the signal-handler
+ * thread receives them as datagrams sent directly by the transmitters to a
+ * socket of its own. Core merely associates each signal context with this
+ * socket when allocating the context.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SOURCE__CLIENT_H_
+#define _INCLUDE__SIGNAL_SOURCE__CLIENT_H_
+
+#include <base/rpc_client.h>
+#include <signal_source/linux_signal_source.h>
+
+/* base-internal includes */
+#include <base/internal/server_socket_pair.h>
+
+namespace Genode { class Signal_source_client; }
+
+
+class Genode::Signal_source_client : public Rpc_client<Linux_signal_source>
+{
+	private:
+
+		/**
+		 * Socket pair of the calling thread, receiving the signals
+		 */
+		Socket_pair const _socket_pair;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * Must be called by the thread that waits for signals.
+		 */
+		Signal_source_client(Capability<Signal_source> cap);
+
+		/**
+		 * Destructor
+		 */
+		~Signal_source_client();
+
+
+		/*****************************
+		 ** Signal source interface **
+		 *****************************/
+
+		Signal wait_for_signal() override;
+};
+
+#endif /* _INCLUDE__SIGNAL_SOURCE__CLIENT_H_ */
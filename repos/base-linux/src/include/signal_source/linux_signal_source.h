@@ -0,0 +1,37 @@
+/*
+ * \brief  Linux-specific signal source RPC interface
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SOURCE__LINUX_SIGNAL_SOURCE_H_
+#define _INCLUDE__SIGNAL_SOURCE__LINUX_SIGNAL_SOURCE_H_
+
+#include <signal_source/signal_source.h>
+#include <base/rpc_server.h>
+
+namespace Genode { struct Linux_signal_source; }
+
+
+struct Genode::Linux_signal_source : Signal_source
+{
+	/**
+	 * Register socket at which the signal receiver waits for signals
+	 *
+	 * The capability refers to the client side of a socket pair owned by
+	 * the signal-handler thread. Core uses it as destination of the
+	 * signal-context capabilities subsequently allocated for the signal
+	 * source.
+	 */
+	GENODE_RPC(Rpc_register_receiver, void, _register_receiver, Native_capability);
+	GENODE_RPC_INTERFACE_INHERIT(Signal_source, Rpc_register_receiver);
+};
+
+#endif /* _INCLUDE__SIGNAL_SOURCE__LINUX_SIGNAL_SOURCE_H_ */
@@ -0,0 +1,42 @@
+/*
+ * \brief  Linux-specific signal-source RPC object
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SIGNAL_SOURCE__RPC_OBJECT_H_
+#define _INCLUDE__SIGNAL_SOURCE__RPC_OBJECT_H_
+
+#include <base/rpc_server.h>
+#include <signal_source/linux_signal_source.h>
+
+namespace Genode { struct Signal_source_rpc_object; }
+
+
+struct Genode::Signal_source_rpc_object : Rpc_object<Linux_signal_source,
+                                                     Signal_source_rpc_object>
+{
+	protected:
+
+		Native_capability _receiver { };
+
+	public:
+
+		void _register_receiver(Native_capability receiver) {
+			_receiver = receiver; }
+
+		/**
+		 * Return socket of the signal receiver, or an invalid capability
+		 * if the client has not registered one
+		 */
+		Native_capability receiver() const { return _receiver; }
+};
+
+#endif /* _INCLUDE__SIGNAL_SOURCE__RPC_OBJECT_H_ */
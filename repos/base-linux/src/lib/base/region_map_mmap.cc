@@ -123,10 +123,11 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
                                   bool                 use_local_addr,
                                   addr_t               local_addr,
                                   bool                 executable,
+                                  bool                 writeable,
                                   bool                 overmap)
 {
 	int  const  fd        = _dataspace_fd(ds);
-	bool const  writable  = _dataspace_writable(ds);
+	bool const  writable  = _dataspace_writable(ds) && writeable;
 
 	int  const  flags     = MAP_SHARED | (overmap ? MAP_FIXED : 0);
 	int  const  prot      = PROT_READ
@@ -172,7 +173,7 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
                                                size_t size, off_t offset,
                                                bool use_local_addr,
                                                Region_map::Local_addr local_addr,
-                                               bool executable)
+                                               bool executable, bool writeable)
 {
 	Lock::Guard lock_guard(lock());
 
@@ -228,7 +229,7 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			throw Region_conflict();
 		}
 
-		_add_to_rmap(Region(local_addr, offset, ds, region_size));
+		_add_to_rmap(Region(local_addr, offset, ds, region_size, writeable));
 
 		/*
 		 * Case 3.1
@@ -239,7 +240,8 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		 * argument as the region was reserved by a PROT_NONE mapping.
 		 */
 		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable, true);
+			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr,
+			           executable, writeable && _base_writeable, true);
 
 		return (void *)local_addr;
 
@@ -268,9 +270,10 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			 * Reserve local address range that can hold the entire sub RM
 			 * session.
 			 */
-			rm->_base = _reserve_local(use_local_addr, local_addr, region_size);
+			rm->_base           = _reserve_local(use_local_addr, local_addr, region_size);
+			rm->_base_writeable = writeable;
 
-			_add_to_rmap(Region(rm->_base, offset, ds, region_size));
+			_add_to_rmap(Region(rm->_base, offset, ds, region_size, writeable));
 
 			/*
 			 * Cases 2.2, 3.2
@@ -286,11 +289,13 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 
 				/*
 				 * We have to enforce the mapping via the 'overmap' argument as
-				 * the region was reserved by a PROT_NONE mapping.
+				 * the region was reserved by a PROT_NONE mapping. A region is
+				 * writeable only if both the region and the sub RM session
+				 * were attached writeable.
 				 */
 				_map_local(region.dataspace(), region.size(), region.offset(),
 				           true, rm->_base + region.start() + region.offset(),
-				           executable, true);
+				           executable, region.writeable() && writeable, true);
 			}
 
 			return rm->_base;
@@ -304,9 +309,9 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			 * Note, we do not overmap.
 			 */
 			void *addr = _map_local(ds, region_size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, writeable);
 
-			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
+			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size, writeable));
 
 			return addr;
 		}
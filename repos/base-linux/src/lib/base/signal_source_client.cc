@@ -0,0 +1,63 @@
+/*
+ * \brief  Linux-specific signal-source client
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <signal_source/client.h>
+
+/* base-internal includes */
+#include <base/internal/native_thread.h>
+#include <base/internal/signal_datagram.h>
+
+using namespace Genode;
+
+
+Signal_source_client::Signal_source_client(Capability<Signal_source> cap)
+:
+	Rpc_client<Linux_signal_source>(static_cap_cast<Linux_signal_source>(cap)),
+
+	/* obtain named socket pair for the calling thread from core */
+	_socket_pair(server_socket_pair())
+{
+	/*
+	 * Let core direct all signal contexts of the signal source to our
+	 * socket.
+	 */
+	call<Rpc_register_receiver>(
+		Capability_space::import(Rpc_destination(_socket_pair.client_sd),
+		                         Rpc_obj_key()));
+}
+
+
+Signal_source_client::~Signal_source_client()
+{
+	destroy_server_socket_pair(_socket_pair);
+
+	if (Thread::myself())
+		Thread::myself()->native_thread().socket_pair = Socket_pair();
+}
+
+
+Signal_source_client::Signal Signal_source_client::wait_for_signal()
+{
+	for (;;) {
+
+		Signal_datagram datagram { 0, 0 };
+
+		/* skip interrupted receive operations and malformed messages */
+		if (!receive_signal_datagram(_socket_pair.server_sd, datagram))
+			continue;
+
+		if (datagram.imprint)
+			return Signal(datagram.imprint, datagram.num);
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * \brief  Linux-specific submission of signals
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/trace/events.h>
+#include <base/signal.h>
+
+/* base-internal includes */
+#include <base/internal/globals.h>
+#include <base/internal/signal_datagram.h>
+
+using namespace Genode;
+
+static Pd_session *_pd;
+
+
+void Genode::init_signal_transmitter(Env &env) { _pd = &env.pd(); }
+
+
+void Signal_transmitter::submit(unsigned cnt)
+{
+	{
+		Trace::Signal_submit trace_event(cnt);
+	}
+
+	if (!_context.valid())
+		return;
+
+	/* common case, deliver signal directly to the receiver */
+	switch (send_signal_datagram(_context, cnt)) {
+
+	case SIGNAL_DELIVERED:
+		return;
+
+	case SIGNAL_CONGESTED:
+
+		/*
+		 * Wait until the receiver drained its socket queue. Handing the
+		 * signal over to core instead would allow later signals of this
+		 * transmitter to overtake it. Core, which has no '_pd', never
+		 * blocks on a receiver.
+		 */
+		if (_pd && send_signal_datagram(_context, cnt, true) == SIGNAL_DELIVERED)
+			return;
+		break;
+
+	case SIGNAL_UNDELIVERABLE:
+		break;
+	}
+
+	/*
+	 * Fall back to core, e.g., if the transmitter lacks a socket to the
+	 * receiver
+	 */
+	if (_pd)
+		_pd->submit(_context, cnt);
+	else
+		warning("missing call of 'init_signal_submit'");
+}
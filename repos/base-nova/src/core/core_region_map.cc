@@ -51,7 +51,7 @@ Region_map::Local_addr
 Core_region_map::attach(Dataspace_capability ds_cap, size_t,
                         off_t offset, bool use_local_addr,
                         Region_map::Local_addr,
-                        bool executable)
+                        bool executable, bool)
 {
 	auto lambda = [&] (Dataspace_component *ds) -> Local_addr {
 		if (!ds)
@@ -24,10 +24,10 @@ Region_map_client::Region_map_client(Capability<Region_map> session)
 Region_map::Local_addr
 Region_map_client::attach(Dataspace_capability ds, size_t size, off_t offset,
                           bool use_local_addr, Local_addr local_addr,
-                          bool executable)
+                          bool executable, bool writeable)
 {
 	return call<Rpc_attach>(ds, size, offset, use_local_addr, local_addr,
-	                        executable);
+	                        executable, writeable);
 }
 
 
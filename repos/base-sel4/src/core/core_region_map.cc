@@ -24,7 +24,8 @@ using namespace Genode;
 
 Region_map::Local_addr
 Core_region_map::attach(Dataspace_capability ds_cap, size_t size, off_t offset,
-                        bool use_local_addr, Region_map::Local_addr, bool)
+                        bool use_local_addr, Region_map::Local_addr, bool,
+                        bool)
 {
 	auto lambda = [&] (Dataspace_component *ds) -> Local_addr {
 		if (!ds)
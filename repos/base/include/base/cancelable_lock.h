@@ -21,6 +21,7 @@ namespace Genode {
 
 	class Thread;
 	class Cancelable_lock;
+	struct Lock_stats;
 }
 
 
@@ -68,6 +69,11 @@ class Genode::Cancelable_lock
 
 		Applicant _owner;
 
+		Lock_stats *_stats = nullptr;
+
+		void _account(bool contended, bool blocked, unsigned spins,
+		              unsigned long long start);
+
 	public:
 
 		enum State { LOCKED, UNLOCKED };
@@ -89,6 +95,15 @@ class Genode::Cancelable_lock
 		 */
 		void unlock();
 
+		/**
+		 * Record contention statistics of the lock
+		 *
+		 * \param stats  statistics object, or 'nullptr' to stop recording
+		 *
+		 * Must not be called while the lock is used by other threads.
+		 */
+		void stats(Lock_stats *stats) { _stats = stats; }
+
 		/**
 		 * Lock guard
 		 */
@@ -57,11 +57,8 @@ class Genode::Entrypoint : Noncopyable
 		{
 			enum { STACK_SIZE = 2*1024*sizeof(long) };
 			Entrypoint &ep;
-			Signal_proxy_thread(Env &env, Entrypoint &ep)
-			:
-				Thread(env, "signal_proxy", STACK_SIZE),
-				ep(ep)
-			{ start(); }
+			Signal_proxy_thread(Env &env, Entrypoint &ep,
+			                    Affinity::Location location);
 
 			void entry() override { ep._process_incoming_signals(); }
 		};
@@ -138,6 +135,14 @@ class Genode::Entrypoint : Noncopyable
 
 		Entrypoint(Env &env, size_t stack_size, char const *name);
 
+		/**
+		 * Constructor
+		 *
+		 * \param location  CPU affinity of the entrypoint's threads
+		 */
+		Entrypoint(Env &env, size_t stack_size, char const *name,
+		           Affinity::Location location);
+
 		~Entrypoint()
 		{
 			_rpc_ep->dissolve(&_signal_proxy);
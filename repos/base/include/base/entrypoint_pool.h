@@ -0,0 +1,122 @@
+/*
+ * \brief  Group of entrypoints serving RPC objects concurrently
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+
+#include <base/env.h>
+#include <base/entrypoint.h>
+#include <base/allocator.h>
+#include <util/string.h>
+
+namespace Genode { class Entrypoint_pool; }
+
+
+/**
+ * Pool of entrypoints for scaling a server across CPUs
+ *
+ * Each RPC object and signal handler is served by exactly one entrypoint
+ * of the pool. Hence, the invocations of an individual object are
+ * serialized whereas different objects, e.g., the sessions of different
+ * clients, are served concurrently. Objects that must be serialized with
+ * each other have to be assigned to the same entrypoint. State shared by
+ * objects of different entrypoints must be protected by the user of the
+ * pool.
+ *
+ * A pool with a single entrypoint refers to the component's initial
+ * entrypoint.
+ */
+class Genode::Entrypoint_pool : Noncopyable
+{
+	public:
+
+		struct Pinned { bool value; };
+
+	private:
+
+		Allocator &_alloc;
+
+		unsigned const _count;
+
+		Entrypoint **_eps;
+
+		Lock     _lock { };
+		unsigned _next = 0;
+
+		bool _owned() const { return _count > 1; }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param count   number of entrypoints
+		 * \param pinned  if true, the entrypoints are distributed over the
+		 *                CPUs of the component's affinity space
+		 */
+		Entrypoint_pool(Env &env, Allocator &alloc, unsigned count,
+		                size_t stack_size, char const *name, Pinned pinned)
+		:
+			_alloc(alloc), _count(max(count, 1U)),
+			_eps((Entrypoint **)_alloc.alloc(_count*sizeof(Entrypoint *)))
+		{
+			if (!_owned()) {
+				_eps[0] = &env.ep();
+				return;
+			}
+
+			Affinity::Space space = env.cpu().affinity_space();
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				Affinity::Location const location = pinned.value
+					? space.location_of_index(i) : Affinity::Location();
+
+				String<32> const ep_name(name, ".", i);
+
+				_eps[i] = new (_alloc)
+					Entrypoint(env, stack_size, ep_name.string(), location);
+			}
+		}
+
+		~Entrypoint_pool()
+		{
+			if (_owned())
+				for (unsigned i = 0; i < _count; i++)
+					destroy(_alloc, _eps[i]);
+
+			_alloc.free(_eps, _count*sizeof(Entrypoint *));
+		}
+
+		unsigned count() const { return _count; }
+
+		Entrypoint &ep(unsigned i) { return *_eps[i % _count]; }
+
+		/**
+		 * Return entrypoint for a new object, assigned in round-robin order
+		 */
+		Entrypoint &next()
+		{
+			Lock::Guard guard(_lock);
+			return *_eps[_next++ % _count];
+		}
+
+		template <typename FN>
+		void for_each(FN const &fn)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				fn(*_eps[i]);
+		}
+};
+
+#endif /* _INCLUDE__BASE__ENTRYPOINT_POOL_H_ */
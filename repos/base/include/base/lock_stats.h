@@ -0,0 +1,61 @@
+/*
+ * \brief  Contention statistics of a lock
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__LOCK_STATS_H_
+#define _INCLUDE__BASE__LOCK_STATS_H_
+
+#include <util/noncopyable.h>
+
+namespace Genode { struct Lock_stats; }
+
+
+/**
+ * Counters for spotting hot locks
+ *
+ * A lock records statistics only if a 'Lock_stats' object is attached to
+ * it via 'Cancelable_lock::stats'. The counters are updated by the
+ * respective lock owner while holding the lock. Each contended acquisition
+ * is additionally reported as 'Trace::Lock_contended' event, which allows
+ * for inspecting the counters of a running component via the trace
+ * infrastructure.
+ */
+struct Genode::Lock_stats : Noncopyable
+{
+	/**
+	 * Source of time stamps used for measuring the wait time
+	 *
+	 * The base library has no notion of time. Hence, the unit of the wait
+	 * time is defined by the user of the statistics, e.g., by passing a
+	 * function that returns 'Trace::timestamp()'.
+	 */
+	typedef unsigned long long (*Timestamp)();
+
+	char const * const name;
+	Timestamp    const timestamp;
+
+	unsigned long      acquisitions = 0;
+	unsigned long      contended    = 0;  /* lock was held by another thread */
+	unsigned long      blocked      = 0;  /* caller blocked after spinning */
+	unsigned long long spins        = 0;  /* polls of the lock state */
+	unsigned long long wait_time    = 0;  /* of contended acquisitions */
+
+	/**
+	 * Constructor
+	 *
+	 * \param timestamp  if 'nullptr', the wait time is not measured
+	 */
+	Lock_stats(char const *name, Timestamp timestamp = nullptr)
+	: name(name), timestamp(timestamp) { }
+};
+
+#endif /* _INCLUDE__BASE__LOCK_STATS_H_ */
@@ -31,6 +31,12 @@ namespace Genode { template <typename> class Object_pool; }
  *
  * The local names of a capabilities are used to differentiate multiple server
  * objects managed by one and the same object pool.
+ *
+ * Each RPC dispatched by an entrypoint looks up the invoked object in the
+ * pool. To allow multiple threads to perform lookups concurrently, the
+ * entries are distributed over several shards according to the hash of
+ * their capability's local name. Each shard is protected by a lock of its
+ * own, which is held only for the duration of the tree search.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool : Interface, Noncopyable
@@ -57,6 +63,9 @@ class Genode::Object_pool : Interface, Noncopyable
 				Untyped_capability _cap  { };
 				Entry_lock         _lock { *this };
 
+				/* shard the entry is inserted in */
+				unsigned _shard = 0;
+
 				inline unsigned long _obj_id() { return _cap.local_name(); }
 
 			public:
@@ -94,29 +103,59 @@ class Genode::Object_pool : Interface, Noncopyable
 
 	private:
 
-		Avl_tree<Entry> _tree { };
-		Lock            _lock { };
+		enum { NUM_SHARDS = 16 };
+
+		struct Shard
+		{
+			Avl_tree<Entry> tree { };
+			Lock            lock { };
+
+			Entry *find(unsigned long obj_id)
+			{
+				return tree.first() ? tree.first()->find_by_obj_id(obj_id)
+				                    : nullptr;
+			}
+		};
+
+		Shard _shards[NUM_SHARDS];
+
+		static unsigned _shard_index(unsigned long obj_id)
+		{
+			/* Fibonacci hashing spreads sequential and aligned IDs alike */
+			unsigned long const hash = obj_id*2654435761UL;
+			return (unsigned)(hash >> 16) % NUM_SHARDS;
+		}
 
 	protected:
 
 		bool empty()
 		{
-			Lock::Guard lock_guard(_lock);
-			return _tree.first() == nullptr;
+			for (unsigned i = 0; i < NUM_SHARDS; i++) {
+				Lock::Guard lock_guard(_shards[i].lock);
+				if (_shards[i].tree.first())
+					return false;
+			}
+			return true;
 		}
 
 	public:
 
 		void insert(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+			Entry &entry = *obj;
+			entry._shard = _shard_index(entry._obj_id());
+
+			Shard &shard = _shards[entry._shard];
+			Lock::Guard lock_guard(shard.lock);
+			shard.tree.insert(obj);
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+			Entry &entry = *obj;
+			Shard &shard = _shards[entry._shard];
+			Lock::Guard lock_guard(shard.lock);
+			shard.tree.remove(obj);
 		}
 
 		template <typename FUNC>
@@ -131,10 +170,10 @@ class Genode::Object_pool : Interface, Noncopyable
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				Shard &shard = _shards[_shard_index(capid)];
+				Lock::Guard lock_guard(shard.lock);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = shard.find(capid);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -160,24 +199,29 @@ class Genode::Object_pool : Interface, Noncopyable
 			using Weak_ptr   = Weak_ptr<typename Entry::Entry_lock>;
 			using Locked_ptr = Locked_ptr<typename Entry::Entry_lock>;
 
-			for (;;) {
-				OBJ_TYPE * obj;
+			for (unsigned i = 0; i < NUM_SHARDS; i++) {
 
-				{
-					Lock::Guard lock_guard(_lock);
+				Shard &shard = _shards[i];
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+				for (;;) {
+					OBJ_TYPE * obj;
 
-					Weak_ptr ptr = obj->_lock.weak_ptr();
 					{
-						Locked_ptr lock_ptr(ptr);
-						if (!lock_ptr.valid()) return;
+						Lock::Guard lock_guard(shard.lock);
 
-						_tree.remove(obj);
+						if (!((obj = (OBJ_TYPE*) shard.tree.first()))) break;
+
+						Weak_ptr ptr = obj->_lock.weak_ptr();
+						{
+							Locked_ptr lock_ptr(ptr);
+							if (!lock_ptr.valid()) return;
+
+							shard.tree.remove(obj);
+						}
 					}
-				}
 
-				func(obj);
+					func(obj);
+				}
 			}
 		}
 };
@@ -17,12 +17,27 @@
 #include <base/stdint.h>
 #include <base/thread.h>
 #include <cpu_session/cpu_session.h>
+#include <cpu/memory_barrier.h>
+#include <util/string.h>
 
 namespace Genode { namespace Trace { class Buffer; } }
 
 
 /**
  * Buffer shared between CPU client thread and TRACE client
+ *
+ * The buffer is a ring of entries written by exactly one thread, the traced
+ * one. Each entry carries a sequence number. The writer never waits for
+ * readers but overwrites the oldest entries once the ring is full. Before
+ * overwriting an entry, the writer advances the tail, which denotes the
+ * oldest entry still intact.
+ *
+ * Readers do not modify the buffer. Each reader keeps its own 'Cursor' and
+ * copies entries out of the buffer. By comparing the sequence number of the
+ * cursor with the tail after copying, a reader detects entries that were
+ * overwritten while being read and counts all entries it missed. Hence, any
+ * number of readers can consume the same buffer concurrently with the writer
+ * without locking.
  */
 class Genode::Trace::Buffer
 {
@@ -32,26 +47,77 @@ class Genode::Trace::Buffer
 		unsigned volatile _size;         /* in bytes */
 		unsigned volatile _wrapped;      /* count of buffer wraps */
 
+		unsigned long volatile _head_seq;    /* sequence number of next entry */
+		unsigned long volatile _tail_seq;    /* sequence number of oldest entry */
+		unsigned      volatile _tail_offset; /* offset of oldest entry */
+		unsigned      volatile _tail_version; /* odd while tail is updated */
+
 		struct _Entry
 		{
-			size_t len;
-			char   data[0];
+			unsigned long seq;
+			size_t        len;  /* 0 marks the end of the ring */
+			char          data[0];
 		};
 
 		_Entry _entries[0];
 
-		_Entry *_head_entry() { return (_Entry *)((addr_t)_entries + _head_offset); }
+		/*
+		 * The 'entries' member marks the beginning of the trace buffer
+		 * entries. No other member variables must follow.
+		 */
 
-		void _buffer_wrapped()
+		static size_t _entry_size(size_t len)
 		{
-			_head_offset = 0;
-			_wrapped++;
+			return align_addr(sizeof(_Entry) + len, log2(sizeof(addr_t)));
 		}
 
-		/*
-		 * The 'entries' member marks the beginning of the trace buffer
-		 * entries. No other member variables must follow.
+		_Entry *_entry(size_t offset) {
+			return (_Entry *)((addr_t)_entries + offset); }
+
+		_Entry const *_entry(size_t offset) const {
+			return (_Entry const *)((addr_t)_entries + offset); }
+
+		bool _empty() const { return _tail_seq == _head_seq; }
+
+		/**
+		 * Return true if the ring has no room for an entry at 'offset'
+		 */
+		bool _end_of_ring(size_t offset) const
+		{
+			return offset + sizeof(_Entry) > _size || _entry(offset)->len == 0;
+		}
+
+		void _set_tail(size_t offset, unsigned long seq)
+		{
+			_tail_version++;
+			memory_barrier();
+			_tail_offset = offset;
+			_tail_seq    = seq;
+			memory_barrier();
+			_tail_version++;
+		}
+
+		/**
+		 * Drop the oldest entries that overlap with the range [head, end)
+		 *
+		 * Called by the writer before writing to the range. Because the
+		 * tail is advanced first, a reader that copies an entry concurrently
+		 * notices that the entry is gone.
 		 */
+		void _evict(size_t end)
+		{
+			while (!_empty()
+			    && _tail_offset >= _head_offset && _tail_offset < end) {
+
+				size_t        offset = _tail_offset + _entry_size(_entry(_tail_offset)->len);
+				unsigned long seq    = _tail_seq + 1;
+
+				if (seq != _head_seq && _end_of_ring(offset))
+					offset = 0;
+
+				_set_tail(offset, seq);
+			}
+		}
 
 	public:
 
@@ -69,20 +135,36 @@ class Genode::Trace::Buffer
 			_size = size - header_size;
 
 			_wrapped = 0;
+
+			_head_seq     = 0;
+			_tail_seq     = 0;
+			_tail_offset  = 0;
+			_tail_version = 0;
 		}
 
 		char *reserve(size_t len)
 		{
-			if (_head_offset + sizeof(_Entry) + len <= _size)
-				return _head_entry()->data;
+			size_t const entry_size = _entry_size(len);
+
+			if (_head_offset + entry_size > _size) {
+
+				/* mark end of the ring with len 0 and wrap */
+				if (_head_offset + sizeof(_Entry) <= _size) {
+					_evict(_size);
+					_entry(_head_offset)->len = 0;
+				}
+
+				_head_offset = 0;
+				_wrapped++;
+			}
 
-			/* mark last entry with len 0 and wrap */
-			if (_head_offset + sizeof(_Entry) <= _size)
-				_head_entry()->len = 0;
+			_evict(_head_offset + entry_size);
 
-			_buffer_wrapped();
+			/* let the tail refer to the upcoming entry if the ring is empty */
+			if (_empty() && _tail_offset != _head_offset)
+				_set_tail(_head_offset, _head_seq);
 
-			return _head_entry()->data;
+			return _entry(_head_offset)->data;
 		}
 
 		void commit(size_t len)
@@ -91,12 +173,14 @@ class Genode::Trace::Buffer
 			if (len == 0)
 				return;
 
-			_head_entry()->len = len;
+			_Entry &entry = *_entry(_head_offset);
+			entry.seq = _head_seq;
+			entry.len = len;
 
-			/* advance head offset, wrap when reaching buffer boundary */
-			_head_offset += sizeof(_Entry) + len;
-			if (_head_offset == _size)
-				_buffer_wrapped();
+			/* publish entry to the readers */
+			memory_barrier();
+			_head_offset += _entry_size(len);
+			_head_seq     = _head_seq + 1;
 		}
 
 		unsigned wrapped() const { return _wrapped; }
@@ -106,47 +190,98 @@ class Genode::Trace::Buffer
 		 ** Functions called from the TRACE client **
 		 ********************************************/
 
-		class Entry
+		/**
+		 * Reading position of a TRACE client
+		 */
+		class Cursor
 		{
 			private:
 
-				_Entry const *_entry;
+				unsigned long _seq    = 0;
+				size_t        _offset = 0;
+				unsigned long _lost   = 0;
 
 				friend class Buffer;
 
-				Entry(_Entry const *entry) : _entry(entry) { }
-
 			public:
 
-				size_t      length() const { return _entry->len; }
-				char const *data()   const { return _entry->data; }
-				bool        last()   const { return _entry == 0; }
-
-				/*
-				 * \deprecated use 'last' instead
+				/**
+				 * Return number of entries overwritten before being read
 				 */
-				bool is_last() const { return last(); }
+				unsigned long lost() const { return _lost; }
 		};
 
-		Entry first() const
+		/**
+		 * Copy next entry to 'dst' and advance cursor
+		 *
+		 * \param dst_len  size of 'dst', longer entries are truncated
+		 *
+		 * \return length of the copied entry, or 0 if the cursor has
+		 *         reached the head of the buffer
+		 */
+		size_t read(Cursor &cursor, char *dst, size_t dst_len) const
 		{
-			return _entries->len ? Entry(_entries) : Entry(0);
+			/*
+			 * Each iteration either returns, advances the cursor, or
+			 * observes a progressing writer. The bound protects the reader
+			 * from a corrupted buffer.
+			 */
+			for (unsigned i = 0; i < 16; i++) {
+
+				if (cursor._seq == _head_seq)
+					return 0;
+
+				/* resynchronize with the tail if we were lapped by the writer */
+				if ((long)(cursor._seq - _tail_seq) < 0) {
+
+					unsigned const version = _tail_version;
+					memory_barrier();
+					size_t        const offset = _tail_offset;
+					unsigned long const seq    = _tail_seq;
+					memory_barrier();
+
+					/* writer is updating the tail, try again later */
+					if ((version & 1) || version != _tail_version)
+						return 0;
+
+					cursor._lost  += seq - cursor._seq;
+					cursor._seq    = seq;
+					cursor._offset = offset;
+					continue;
+				}
+
+				if (_end_of_ring(cursor._offset)) {
+					cursor._offset = 0;
+					continue;
+				}
+
+				_Entry const &entry = *_entry(cursor._offset);
+
+				unsigned long const seq = entry.seq;
+				size_t        const len = entry.len;
+
+				if (seq != cursor._seq || len > _size - cursor._offset - sizeof(_Entry))
+					continue;
+
+				size_t const copy_len = min(len, dst_len);
+				memcpy(dst, entry.data, copy_len);
+
+				/* discard the copy if the writer overwrote the entry meanwhile */
+				memory_barrier();
+				if ((long)(cursor._seq - _tail_seq) < 0)
+					continue;
+
+				cursor._seq++;
+				cursor._offset += _entry_size(len);
+				return copy_len;
+			}
+			return 0;
 		}
 
-		Entry next(Entry entry) const
-		{
-			if (entry.last())
-				return Entry(0);
-
-			if (entry.length() == 0)
-				return Entry(0);
-
-			addr_t const offset = (addr_t)entry._entry - (addr_t)_entries;
-			if (offset + entry.length() + sizeof(_Entry) > _size)
-				return Entry(0);
-
-			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
-		}
+		/**
+		 * Return true if the buffer holds entries not yet read via 'cursor'
+		 */
+		bool available(Cursor const &cursor) const { return cursor._seq != _head_seq; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__BUFFER_H_ */
@@ -25,6 +25,7 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Lock_contended;
 } }
 
 
@@ -121,4 +122,16 @@ struct Genode::Trace::Signal_received
 };
 
 
+struct Genode::Trace::Lock_contended
+{
+	Lock_stats const &stats;
+
+	Lock_contended(Lock_stats const &stats) : stats(stats)
+	{ Thread::trace(this); }
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.lock_contended(dst, stats); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
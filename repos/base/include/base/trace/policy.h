@@ -21,6 +21,7 @@ namespace Genode {
 	class Msgbuf_base;
 	class Signal_context;
 	class Rpc_object_base;
+	struct Lock_stats;
 
 	namespace Trace { class Policy_module; }
 }
@@ -38,6 +39,7 @@ struct Genode::Trace::Policy_module
 	size_t (*rpc_reply)       (char *, char const *);
 	size_t (*signal_submit)   (char *, unsigned const);
 	size_t (*signal_received) (char *, Signal_context const &, unsigned const);
+	size_t (*lock_contended)  (char *, Lock_stats const &);
 };
 
 #endif /* _INCLUDE__BASE__TRACE__POLICY_H_ */
@@ -21,6 +21,7 @@
 #include <base/allocator.h>
 #include <base/rpc_server.h>
 #include <base/entrypoint.h>
+#include <base/entrypoint_pool.h>
 #include <base/service.h>
 #include <util/arg_string.h>
 #include <base/log.h>
@@ -107,6 +108,45 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		 */
 		Rpc_entrypoint *_ep;
 
+		/*
+		 * Optional pool of entrypoints, over which the session objects
+		 * are distributed
+		 */
+		Entrypoint_pool *_ep_pool = nullptr;
+
+		/**
+		 * Apply functor to session object, looked up at the entrypoint
+		 * that manages it
+		 *
+		 * The functor is called with a nullptr if no session object
+		 * corresponds to the capability.
+		 */
+		template <typename FN>
+		void _apply(Session_capability cap, FN const &fn)
+		{
+			if (!_ep_pool) {
+				_ep->apply(cap, [&] (SESSION_TYPE *s) { fn(*_ep, s); });
+				return;
+			}
+
+			bool found = false;
+			_ep_pool->for_each([&] (Entrypoint &ep) {
+				if (found)
+					return;
+
+				ep.rpc_ep().apply(cap, [&] (SESSION_TYPE *s) {
+					if (!s)
+						return;
+
+					found = true;
+					fn(ep.rpc_ep(), s);
+				});
+			});
+
+			if (!found)
+				fn(*_ep, nullptr);
+		}
+
 		/*
 		 * Allocator for allocating session objects.
 		 * This allocator must be used by the derived
@@ -196,8 +236,12 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			 * Consider that the session-object constructor may already have
 			 * called 'manage'.
 			 */
-			if (!s->cap().valid())
-				_ep->manage(s);
+			if (!s->cap().valid()) {
+				if (_ep_pool)
+					_ep_pool->next().manage(*s);
+				else
+					_ep->manage(s);
+			}
 
 			aquire_guard.ack = true;
 			return *s;
@@ -304,6 +348,20 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			_ep(ep), _md_alloc(md_alloc)
 		{ }
 
+		/**
+		 * Constructor
+		 *
+		 * \param ep_pool   entrypoints over which the sessions of this root
+		 *                  interface are distributed in round-robin order
+		 * \param md_alloc  meta-data allocator providing the backing store
+		 *                  for session objects
+		 */
+		Root_component(Entrypoint_pool &ep_pool, Allocator &md_alloc)
+		:
+			_ep(&ep_pool.ep(0).rpc_ep()), _ep_pool(&ep_pool),
+			_md_alloc(&md_alloc)
+		{ }
+
 
 		/**************************************
 		 ** Local_service::Factory interface **
@@ -346,7 +404,7 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			if (!args.valid_string()) throw Service_denied();
 
-			_ep->apply(session, [&] (SESSION_TYPE *s) {
+			_apply(session, [&] (Rpc_entrypoint &, SESSION_TYPE *s) {
 				if (!s) return;
 
 				_upgrade_session(s, args.string());
@@ -357,11 +415,11 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			SESSION_TYPE * session;
 
-			_ep->apply(session_cap, [&] (SESSION_TYPE *s) {
+			_apply(session_cap, [&] (Rpc_entrypoint &ep, SESSION_TYPE *s) {
 				session = s;
 
 				/* let the entry point forget the session object */
-				if (session) _ep->dissolve(session);
+				if (session) ep.dissolve(session);
 			});
 
 			if (!session) return;
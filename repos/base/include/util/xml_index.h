@@ -0,0 +1,262 @@
+/*
+ * \brief  Pre-parsed representation of an XML document
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+
+namespace Genode { class Xml_index; }
+
+
+/**
+ * Index of the nodes and attributes of an XML document
+ *
+ * An 'Xml_node' scans the XML data each time a sub node, a sibling, or an
+ * attribute is requested, and the construction of each node scans the node
+ * up to its end tag. For large documents that are traversed many times,
+ * the index tokenizes the document once into a table of nodes and
+ * attributes. The nodes obtained via 'xml()' provide the regular 'Xml_node'
+ * interface but look up their sub nodes, siblings, and attributes in the
+ * table.
+ *
+ * The index refers to the XML data, which must remain unmodified and
+ * accessible during the lifetime of the index. 'Xml_node' objects obtained
+ * from the index must not be used after the destruction of the index.
+ *
+ * In contrast to 'Xml_node', which validates the nesting of a sub node not
+ * before the sub node is accessed, the index requires the whole document
+ * to be well-formed.
+ */
+class Genode::Xml_index : Noncopyable
+{
+	private:
+
+		typedef Xml_node::Token   Token;
+		typedef Xml_node::Tag     Tag;
+		typedef Xml_node::Comment Comment;
+		typedef Xml_node_table    Table;
+
+		/**
+		 * Growable array of plain data
+		 */
+		template <typename T>
+		struct Array : Noncopyable
+		{
+			Allocator &alloc;
+
+			T       *elem     = nullptr;
+			unsigned capacity = 0;
+			unsigned count    = 0;
+
+			Array(Allocator &alloc) : alloc(alloc) { }
+
+			~Array() { if (elem) alloc.free(elem, capacity*sizeof(T)); }
+
+			void append(T const &value)
+			{
+				if (count == capacity) {
+					unsigned const new_capacity = max(2*capacity, 64U);
+
+					T *new_elem = (T *)alloc.alloc(new_capacity*sizeof(T));
+					if (elem) {
+						memcpy(new_elem, elem, count*sizeof(T));
+						alloc.free(elem, capacity*sizeof(T));
+					}
+					elem     = new_elem;
+					capacity = new_capacity;
+				}
+				elem[count++] = value;
+			}
+		};
+
+		Array<Table::Node>  _nodes;
+		Array<unsigned>     _children;
+		Array<char const *> _attrs;
+
+		Table _table { };
+
+		/**
+		 * Node with start tag on the path to the current node
+		 */
+		struct Open_node
+		{
+			unsigned    id;
+			unsigned    last_child;
+			char const *content;     /* begin of node content */
+		};
+
+		unsigned _add_node(Tag const &tag, char const *addr)
+		{
+			unsigned const id = _nodes.count;
+
+			Table::Node node { addr, nullptr, tag.name().start(), tag.name().len(),
+			                   Table::NONE, Table::NONE, 0, _attrs.count, 0 };
+
+			try {
+				for (Xml_attribute a = tag.attribute(); ; a = a.next()) {
+					_attrs.append(a._name.start());
+					node.num_attrs++;
+				}
+			} catch (Xml_attribute::Nonexistent_attribute) { }
+
+			_nodes.append(node);
+			return id;
+		}
+
+		/**
+		 * Tokenize XML data into the node and attribute tables
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 */
+		void _parse(char const *base, size_t len)
+		{
+			Tag const root(Xml_node::skip_non_tag_characters(Token(base, len)));
+
+			if (!root.node())
+				throw Xml_node::Invalid_syntax();
+
+			_add_node(root, base);
+
+			if (root.type() == Tag::EMPTY)
+				return;
+
+			Array<Open_node> open(_nodes.alloc);
+			open.append(Open_node { 0, Table::NONE, root.next_token().start() });
+
+			Token curr = root.next_token();
+
+			while (curr.type() != Token::END) {
+
+				/* eat XML comment */
+				Comment const comment(curr);
+				if (comment.valid()) {
+					curr = comment.next_token();
+					continue;
+				}
+
+				/* skip all tokens that are no tags */
+				Tag const tag(curr);
+				if (tag.type() == Tag::INVALID) {
+					curr = curr.next();
+					continue;
+				}
+
+				curr = tag.next_token();
+
+				Open_node &parent = open.elem[open.count - 1];
+
+				if (tag.node()) {
+
+					/*
+					 * Like 'Xml_node::sub_node', the first sub node starts
+					 * at the begin of the content of its parent.
+					 */
+					unsigned const id =
+						_add_node(tag, parent.last_child == Table::NONE
+						               ? parent.content : tag.token().start());
+
+					Table::Node &parent_node = _nodes.elem[parent.id];
+					if (parent.last_child == Table::NONE)
+						parent_node.children = id;
+					else
+						_nodes.elem[parent.last_child].next_sibling = id;
+
+					parent.last_child = id;
+					parent_node.num_sub_nodes++;
+
+					if (tag.type() == Tag::START)
+						open.append(Open_node { id, Table::NONE, curr.start() });
+
+					continue;
+				}
+
+				/* end tag must match the start tag of the same depth */
+				Table::Node &node = _nodes.elem[parent.id];
+				if (tag.name().len() != node.name_len
+				 || strcmp(tag.name().start(), node.name, node.name_len))
+					throw Xml_node::Invalid_syntax();
+
+				node.end_tag = tag.token().start();
+
+				if (--open.count == 0)
+					return;
+			}
+
+			/* missing end tag */
+			throw Xml_node::Invalid_syntax();
+		}
+
+		/**
+		 * Store the sub nodes of each node consecutively in '_children'
+		 */
+		void _populate_children()
+		{
+			for (unsigned i = 0; i < _nodes.count; i++) {
+
+				Table::Node &node = _nodes.elem[i];
+
+				unsigned child = node.children;
+				node.children = _children.count;
+
+				for (; child != Table::NONE; child = _nodes.elem[child].next_sibling)
+					_children.append(child);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator for the node and attribute tables
+		 * \param base   begin of XML data
+		 * \param len    length of XML data
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Xml_index(Allocator &alloc, char const *base, size_t len = ~0UL)
+		:
+			_nodes(alloc), _children(alloc), _attrs(alloc)
+		{
+			_parse(base, len);
+			_populate_children();
+
+			_table.node  = _nodes.elem;
+			_table.child = _children.elem;
+			_table.attr  = _attrs.elem;
+			_table.base  = base;
+			_table.len   = len;
+		}
+
+		/**
+		 * Constructor
+		 *
+		 * Index the XML data of an existing node
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		: Xml_index(alloc, node.addr(), node.size()) { }
+
+		/**
+		 * Return top-level node of the document
+		 */
+		Xml_node xml() const { return Xml_node(_table, 0); }
+
+		unsigned num_nodes() const { return _nodes.count; }
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
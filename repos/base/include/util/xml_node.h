@@ -20,9 +20,52 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
+	struct Xml_node_table;
 }
 
 
+/**
+ * Table of nodes and attributes of a pre-parsed XML document
+ *
+ * The table is populated by 'Xml_index' and refers to the unmodified
+ * XML data. It enables an 'Xml_node' to access its sub nodes, siblings,
+ * and attributes without scanning the XML data.
+ *
+ * \noapi
+ */
+struct Genode::Xml_node_table
+{
+	enum { NONE = ~0U };
+
+	struct Node
+	{
+		char const *addr;          /* begin of node                    */
+		char const *end_tag;       /* end tag, or nullptr if empty tag */
+		char const *name;          /* type name of node                */
+		size_t      name_len;
+		unsigned    next_sibling;  /* index of next node at same level */
+		unsigned    children;      /* index of first entry in 'child'  */
+		unsigned    num_sub_nodes;
+		unsigned    attrs;         /* index of first entry in 'attr'   */
+		unsigned    num_attrs;
+	};
+
+	Node        const *node  = nullptr;
+	unsigned    const *child = nullptr;  /* node indices of sub nodes   */
+	char const *const *attr  = nullptr;  /* first tokens of attributes  */
+
+	char const *base = nullptr;          /* begin of XML data           */
+	size_t      len  = 0;                /* length of XML data          */
+
+	bool has_type(unsigned id, char const *type) const
+	{
+		return strlen(type) == node[id].name_len
+		    && strcmp(type, node[id].name, node[id].name_len) == 0;
+	}
+};
+
+
 /**
  * Representation of an XML-node attribute
  *
@@ -49,6 +92,7 @@ class Genode::Xml_attribute
 		Token _value;
 
 		friend class Xml_node;
+		friend class Xml_index;
 
 		/*
 		 * Even though 'Tag' is part of 'Xml_node', the friendship
@@ -449,6 +493,40 @@ class Genode::Xml_node
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		/*
+		 * Table of the pre-parsed document, or nullptr if the node is
+		 * not part of an 'Xml_index'
+		 */
+		Xml_node_table const *_table = nullptr;
+		unsigned              _id    = 0;
+
+		friend class Xml_index;
+
+		static size_t _remaining(Xml_node_table const &table, char const *at) {
+			return table.len - (at - table.base); }
+
+		/**
+		 * Constructor used for nodes of a pre-parsed document
+		 */
+		Xml_node(Xml_node_table const &table, unsigned id)
+		:
+			_addr(table.node[id].addr),
+			_max_len(_remaining(table, _addr)),
+			_num_sub_nodes(table.node[id].num_sub_nodes),
+			_start_tag(skip_non_tag_characters(Token(_addr, _max_len))),
+			_end_tag(table.node[id].end_tag
+			         ? Tag(Token(table.node[id].end_tag,
+			                     _remaining(table, table.node[id].end_tag)))
+			         : _start_tag),
+			_table(&table), _id(id)
+		{ }
+
+		/**
+		 * Return table index of the sub node with index 'idx'
+		 */
+		unsigned _child(unsigned idx) const {
+			return _table->child[_table->node[_id].children + idx]; }
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -720,6 +798,18 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			/*
+			 * Within a pre-parsed document, the siblings of the root node
+			 * are not indexed.
+			 */
+			if (_table && _id != 0) {
+				unsigned const sibling = _table->node[_id].next_sibling;
+				if (sibling == Xml_node_table::NONE)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_table, sibling);
+			}
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -757,6 +847,13 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_table) {
+				if (idx >= (unsigned)_num_sub_nodes)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_table, _child(idx));
+			}
+
 			if (_num_sub_nodes > 0) {
 
 				/* look up node at specified index */
@@ -778,6 +875,14 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(const char *type) const
 		{
+			if (_table) {
+				for (unsigned i = 0; i < (unsigned)_num_sub_nodes; i++)
+					if (_table->has_type(_child(i), type))
+						return Xml_node(*_table, _child(i));
+
+				throw Nonexistent_sub_node();
+			}
+
 			if (_num_sub_nodes > 0) {
 
 				/* search for sub node of specified type */
@@ -801,6 +906,13 @@ class Genode::Xml_node
 			if (_num_sub_nodes == 0)
 				return;
 
+			if (_table) {
+				for (unsigned i = 0; i < (unsigned)_num_sub_nodes; i++)
+					if (!type || _table->has_type(_child(i), type))
+						fn(Xml_node(*_table, _child(i)));
+				return;
+			}
+
 			Xml_node node = sub_node();
 			for (int i = 0; ; node = node.next()) {
 
@@ -831,6 +943,15 @@ class Genode::Xml_node
 		 */
 		Xml_attribute attribute(unsigned idx) const
 		{
+			if (_table) {
+				Xml_node_table::Node const &node = _table->node[_id];
+				if (idx >= node.num_attrs)
+					throw Nonexistent_attribute();
+
+				char const * const at = _table->attr[node.attrs + idx];
+				return Xml_attribute(Token(at, _remaining(*_table, at)));
+			}
+
 			/* get first attribute of the node */
 			Xml_attribute a = _start_tag.attribute();
 
@@ -850,6 +971,17 @@ class Genode::Xml_node
 		 */
 		Xml_attribute attribute(const char *type) const
 		{
+			if (_table) {
+				Xml_node_table::Node const &node = _table->node[_id];
+				for (unsigned i = 0; i < node.num_attrs; i++) {
+					char const * const at = _table->attr[node.attrs + i];
+					Xml_attribute a(Token(at, _remaining(*_table, at)));
+					if (a.has_type(type))
+						return a;
+				}
+				throw Nonexistent_attribute();
+			}
+
 			/* iterate, beginning with the first attribute of the node */
 			for (Xml_attribute a = _start_tag.attribute(); ; a = a.next())
 				if (a.has_type(type))
@@ -213,10 +213,17 @@ int Rm_client::pager(Ipc_pager &pager)
 		/*
 		 * Check if dataspace is compatible with page-fault type
 		 */
-		if (pf_type == Region_map::State::WRITE_FAULT && !dsc->writable()) {
+		if (pf_type == Region_map::State::WRITE_FAULT &&
+		    (!dsc->writable() || !region->write())) {
 
-			print_page_fault("attempted write at read-only memory",
-			                 pf_addr, pf_ip, pf_type, *this);
+			/*
+			 * Write accesses to read-only attachments within managed
+			 * dataspaces are expected to be resolved by the fault handler,
+			 * e.g., for implementing copy-on-write.
+			 */
+			if (!dsc->writable() || region_map == member_rm())
+				print_page_fault("attempted write at read-only memory",
+				                 pf_addr, pf_ip, pf_type, *this);
 
 			/* register fault at responsible region map */
 			if (region_map)
@@ -337,7 +344,8 @@ Mapping Region_map_component::create_map_item(Region_map_component *,
 
 	return Mapping(dst_fault_area.base(), src_fault_area.base(),
 	               dsc->cacheability(), dsc->io_mem(),
-	               map_size_log2, dsc->writable(), region->executable());
+	               map_size_log2, dsc->writable() && region->write(),
+	               region->executable());
 };
 
 
@@ -345,7 +353,7 @@ Region_map::Local_addr
 Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
                              off_t offset, bool use_local_addr,
                              Region_map::Local_addr local_addr,
-                             bool executable)
+                             bool executable, bool writeable)
 {
 	/* serialize access */
 	Lock::Guard lock_guard(_lock);
@@ -427,7 +435,7 @@ Region_map_component::attach(Dataspace_capability ds_cap, size_t size,
 
 		/* store attachment info in meta data */
 		try {
-			_map.metadata(attach_at, Rm_region((addr_t)attach_at, size, true,
+			_map.metadata(attach_at, Rm_region((addr_t)attach_at, size, writeable,
 			                                   dsc, offset, this, executable));
 		}
 		catch (Allocator_avl_tpl<Rm_region>::Assign_metadata_failed) {
@@ -67,7 +67,7 @@ class Stack_area_region_map : public Region_map
 		 * Allocate and attach on-the-fly backing store to stack area
 		 */
 		Local_addr attach(Dataspace_capability, size_t size, off_t,
-		                  bool, Local_addr local_addr, bool) override
+		                  bool, Local_addr local_addr, bool, bool) override
 		{
 			/* allocate physical memory */
 			size = round_page(size);
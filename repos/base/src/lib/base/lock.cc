@@ -13,6 +13,8 @@
 
 /* Genode includes */
 #include <base/cancelable_lock.h>
+#include <base/lock_stats.h>
+#include <base/trace/events.h>
 #include <cpu/memory_barrier.h>
 
 /* base-internal includes */
@@ -60,10 +62,62 @@ void Cancelable_lock::Applicant::wake_up()
  ** Cancelable lock **
  *********************/
 
+/*
+ * Number of polls of the lock state before blocking
+ *
+ * Most critical sections are short. Hence, a lock held by another thread
+ * often becomes free within a few polls, which spares the costly blocking
+ * and waking up of the caller.
+ */
+enum { SPIN_LIMIT = 128 };
+
+
+void Cancelable_lock::_account(bool const contended, bool const blocked,
+                               unsigned const spins,
+                               unsigned long long const start)
+{
+	Lock_stats &stats = *_stats;
+
+	stats.acquisitions++;
+
+	if (!contended)
+		return;
+
+	stats.contended++;
+	stats.spins += spins;
+
+	if (blocked)
+		stats.blocked++;
+
+	if (stats.timestamp)
+		stats.wait_time += stats.timestamp() - start;
+
+	Trace::Lock_contended trace_event(stats);
+}
+
+
 void Cancelable_lock::lock()
 {
 	Applicant myself(Thread::myself());
 
+	unsigned long long const start = (_stats && _stats->timestamp)
+	                               ? _stats->timestamp() : 0;
+
+	/*
+	 * Spin while the lock is held by another thread that has no applicants
+	 * queued. Once applicants are queued, the lock is handed over to them in
+	 * order and does not become free in between. So spinning would not pay
+	 * off and the caller could not overtake the queued applicants anyway.
+	 */
+	unsigned spins = 0;
+	while (spins < SPIN_LIMIT && _state == LOCKED
+	    && _last_applicant == &_owner && _owner != myself) {
+		memory_barrier();
+		spins++;
+	}
+
+	bool const contended = (spins > 0);
+
 	spinlock_lock(&_spinlock_state);
 
 	if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
@@ -72,6 +126,9 @@ void Cancelable_lock::lock()
 		_owner          =  myself;
 		_last_applicant = &_owner;
 		spinlock_unlock(&_spinlock_state);
+
+		if (_stats)
+			_account(contended, false, spins, start);
 		return;
 	}
 
@@ -149,6 +206,9 @@ void Cancelable_lock::lock()
 		throw Blocking_canceled();
 	}
 	spinlock_unlock(&_spinlock_state);
+
+	if (_stats)
+		_account(true, true, spins, start);
 }
 
 
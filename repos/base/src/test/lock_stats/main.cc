@@ -0,0 +1,163 @@
+/*
+ * \brief  Test for the contention statistics of locks
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The test attaches a 'Lock_stats' object to a lock and lets several
+ * threads compete for the lock. In the first phase, the main thread holds
+ * the lock while the other threads try to acquire it, which forces each of
+ * them to wait. In the second phase, the threads hammer the lock. At the
+ * end, the counters are checked against the number of acquisitions.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/lock.h>
+#include <base/lock_stats.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Worker;
+	struct Main;
+}
+
+
+struct Test::Worker : Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long), ROUNDS = 10000 };
+
+	Lock          &_lock;
+	unsigned long &_counter;
+	Semaphore     &_ready;
+	Semaphore     &_start;
+	Semaphore     &_done;
+
+	Worker(Env &env, unsigned index, Lock &lock, unsigned long &counter,
+	       Semaphore &ready, Semaphore &start, Semaphore &done)
+	:
+		Thread(env, Name("worker.", index), STACK_SIZE),
+		_lock(lock), _counter(counter),
+		_ready(ready), _start(start), _done(done)
+	{ }
+
+	void entry() override
+	{
+		/* phase 1: the lock is held by the main thread */
+		_ready.up();
+		{
+			Lock::Guard guard(_lock);
+			_counter++;
+		}
+
+		/* phase 2: compete with the other workers */
+		_start.down();
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			Lock::Guard guard(_lock);
+			_counter++;
+
+			/* stay a while in the critical section */
+			for (unsigned volatile j = 0; j < 100; j++);
+		}
+		_done.up();
+	}
+};
+
+
+struct Test::Main
+{
+	enum { NUM_WORKERS = 4 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Lock_stats    _stats   { "test" };
+	Lock          _lock    { };
+	unsigned long _counter { 0 };
+
+	Semaphore _ready { }, _start { }, _done { };
+
+	Constructible<Worker> _workers[NUM_WORKERS];
+
+	bool _check(char const *what, bool condition)
+	{
+		if (!condition)
+			error("unexpected statistics: ", what);
+		return condition;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- lock statistics test ---");
+
+		_lock.stats(&_stats);
+
+		_lock.lock();
+
+		for (unsigned i = 0; i < NUM_WORKERS; i++)
+			_workers[i].construct(_env, i, _lock, _counter, _ready, _start, _done);
+
+		for (unsigned i = 0; i < NUM_WORKERS; i++)
+			_workers[i]->start();
+
+		/* give the workers the chance to wait for the lock */
+		for (unsigned i = 0; i < NUM_WORKERS; i++)
+			_ready.down();
+		_timer.msleep(100);
+
+		_lock.unlock();
+
+		for (unsigned i = 0; i < NUM_WORKERS; i++)
+			_start.up();
+
+		for (unsigned i = 0; i < NUM_WORKERS; i++)
+			_done.down();
+
+		unsigned long const expected = NUM_WORKERS*(1 + Worker::ROUNDS);
+
+		/* the acquisition of the main thread is accounted as well */
+		_lock.lock();
+
+		log("acquisitions=", _stats.acquisitions, " "
+		    "contended=",    _stats.contended,    " "
+		    "blocked=",      _stats.blocked,      " "
+		    "spins=",        _stats.spins);
+
+		bool ok = true;
+		ok &= _check("counter",      _counter == expected);
+		ok &= _check("acquisitions", _stats.acquisitions == expected + 2);
+		ok &= _check("contended",    _stats.contended >= NUM_WORKERS);
+		ok &= _check("blocked",      _stats.blocked >= 1
+		                          && _stats.blocked <= _stats.contended);
+		ok &= _check("spins",        _stats.spins > 0);
+
+		_lock.unlock();
+		_lock.stats(nullptr);
+
+		if (!ok) {
+			error("lock statistics test failed");
+			_env.parent().exit(1);
+			return;
+		}
+
+		log("--- lock statistics test finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
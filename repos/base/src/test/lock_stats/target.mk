@@ -0,0 +1,3 @@
+TARGET = test-lock_stats
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,220 @@
+/*
+ * \brief  Benchmark for capability lookups by concurrently dispatched RPCs
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The benchmark resembles a server with one entrypoint per CPU, whose RPC
+ * functions look up objects managed by a shared entrypoint, like core does
+ * for dataspace capabilities passed as RPC arguments. Each server entrypoint
+ * is called by a client thread on the same CPU. The number of RPCs per
+ * second is measured for an increasing number of concurrently active
+ * client-server pairs. With an object pool that serializes all lookups, the
+ * throughput does not scale with the number of CPUs.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	/**
+	 * Interface of the objects looked up by the servers
+	 */
+	struct Object_interface : Interface
+	{
+		GENODE_RPC(Rpc_nop, void, nop);
+		GENODE_RPC_INTERFACE(Rpc_nop);
+	};
+
+	/**
+	 * Interface of the servers called by the client threads
+	 */
+	struct Server_interface : Interface
+	{
+		GENODE_RPC(Rpc_lookup, bool, lookup, unsigned long);
+		GENODE_RPC_INTERFACE(Rpc_lookup);
+	};
+
+	struct Object;
+	struct Server;
+	struct Server_client;
+	struct Client_thread;
+	struct Main;
+}
+
+
+struct Test::Object : Rpc_object<Object_interface, Object>
+{
+	void nop() { }
+};
+
+
+struct Test::Server : Rpc_object<Server_interface, Server>
+{
+	Rpc_entrypoint &_objects_ep;
+
+	Server(Rpc_entrypoint &objects_ep) : _objects_ep(objects_ep) { }
+
+	bool lookup(unsigned long local_name)
+	{
+		return _objects_ep.apply(local_name, [&] (Object *obj) {
+			return obj != nullptr; });
+	}
+};
+
+
+struct Test::Server_client : Rpc_client<Server_interface>
+{
+	Server_client(Capability<Server_interface> cap)
+	: Rpc_client<Server_interface>(cap) { }
+
+	bool lookup(unsigned long local_name) {
+		return call<Rpc_lookup>(local_name); }
+};
+
+
+struct Test::Client_thread : Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Server_client _server;
+
+	unsigned long const *_names;
+	unsigned      const  _num_names;
+
+	Semaphore     &_start;
+	Semaphore     &_done;
+	bool volatile &_stop;
+
+	unsigned long calls  = 0;
+	unsigned long misses = 0;
+
+	Client_thread(Env &env, unsigned index, Affinity::Location location,
+	              Capability<Server_interface> server,
+	              unsigned long const *names, unsigned num_names,
+	              Semaphore &start, Semaphore &done, bool volatile &stop)
+	:
+		Thread(env, Name("client.", index), STACK_SIZE, location, Weight(),
+		       env.cpu()),
+		_server(server), _names(names), _num_names(num_names),
+		_start(start), _done(done), _stop(stop)
+	{ }
+
+	void entry() override
+	{
+		_start.down();
+
+		for (unsigned i = 0; !_stop; i++)
+			if (!_server.lookup(_names[i % _num_names]))
+				misses++;
+			else
+				calls++;
+
+		_done.up();
+	}
+};
+
+
+struct Test::Main
+{
+	enum { NUM_OBJECTS = 256, MAX_CPUS = 64, DURATION_MS = 2000,
+	       STACK_SIZE = 4*1024*sizeof(long) };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Affinity::Space _cpus = _env.cpu().affinity_space();
+
+	Rpc_entrypoint _objects_ep { &_env.pd(), STACK_SIZE, "objects" };
+
+	Object        _objects[NUM_OBJECTS];
+	unsigned long _names  [NUM_OBJECTS] { };
+
+	unsigned const _num_cpus = min(_cpus.total(), (unsigned)MAX_CPUS);
+
+	/* one server entrypoint per CPU */
+	Rpc_entrypoint              *_eps    [MAX_CPUS] { };
+	Server                      *_servers[MAX_CPUS] { };
+	Capability<Server_interface> _caps   [MAX_CPUS] { };
+
+	void _measure(unsigned num_threads)
+	{
+		Semaphore     start { }, done { };
+		bool volatile stop = false;
+
+		Client_thread *threads[MAX_CPUS];
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			threads[i] = new (_heap)
+				Client_thread(_env, i, _cpus.location_of_index(i), _caps[i],
+				              _names, NUM_OBJECTS, start, done, stop);
+			threads[i]->start();
+		}
+
+		for (unsigned i = 0; i < num_threads; i++)
+			start.up();
+
+		_timer.msleep(DURATION_MS);
+		stop = true;
+
+		for (unsigned i = 0; i < num_threads; i++)
+			done.down();
+
+		unsigned long calls = 0, misses = 0;
+		for (unsigned i = 0; i < num_threads; i++) {
+			calls  += threads[i]->calls;
+			misses += threads[i]->misses;
+			threads[i]->join();
+			destroy(_heap, threads[i]);
+		}
+
+		log(num_threads, " thread(s): ", (calls*1000)/DURATION_MS, " RPCs/s");
+
+		if (misses)
+			error(misses, " lookups failed");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC contention benchmark ---");
+		log("detected ", _cpus.width(), "x", _cpus.height(), " CPU",
+		    _cpus.total() > 1 ? "s" : "");
+
+		for (unsigned i = 0; i < NUM_OBJECTS; i++)
+			_names[i] = _objects_ep.manage(&_objects[i]).local_name();
+
+		for (unsigned i = 0; i < _num_cpus; i++) {
+			_eps[i] = new (_heap) Rpc_entrypoint(&_env.pd(), STACK_SIZE, "server",
+			                                     true, _cpus.location_of_index(i));
+			_servers[i] = new (_heap) Server(_objects_ep);
+			_caps[i]    = _eps[i]->manage(_servers[i]);
+		}
+
+		for (unsigned n = 1; n <= _num_cpus; n++)
+			_measure(n);
+
+		log("--- RPC contention benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
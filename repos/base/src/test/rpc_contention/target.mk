@@ -0,0 +1,3 @@
+TARGET = test-rpc_contention
+SRC_CC = main.cc
+LIBS   = base
@@ -14,6 +14,7 @@
 #include "sched.h"
 #include <base/allocator_avl.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <block_session/connection.h>
 #include <rump/env.h>
 #include <rump_fs/fs.h>
@@ -25,18 +26,157 @@ enum  { GENODE_FD = 64 };
 
 /**
  * Block session connection
+ *
+ * Block requests are issued asynchronously. 'submit' merely hands the
+ * request to the block server and returns. A dedicated completion thread
+ * processes the acknowledgements in the order they arrive and completes the
+ * requests by calling the 'biodone' callback of the rump kernel. This way,
+ * the rump kernel can keep many requests in flight at the block server.
  */
 class Backend
 {
 	private:
 
+		enum {
+			TX_BUF_SIZE  = 1024*1024,
+			MAX_REQUESTS = Block::Session::TX_QUEUE_SIZE - 1
+		};
+
+		struct Request
+		{
+			Block::Packet_descriptor packet  { };
+			bool                     in_use  = false;
+			int                      op      = 0;
+			void                    *data    = nullptr;
+			size_t                   length  = 0;
+			rump_biodone_fn          biodone = nullptr;
+			void                    *donearg = nullptr;
+		};
+
 		Genode::Allocator_avl              _alloc { &Rump::env().heap() };
-		Block::Connection                  _session { Rump::env().env(), &_alloc };
+		Block::Connection                  _session { Rump::env().env(), &_alloc, TX_BUF_SIZE };
 		Genode::size_t                     _blk_size; /* block size of the device   */
 		Block::sector_t                    _blk_cnt;  /* number of blocks of device */
 		Block::Session::Operations         _blk_ops;
 		Genode::Lock                       _session_lock;
 
+		/*
+		 * The following members are protected by '_session_lock'
+		 */
+		Request  _requests[MAX_REQUESTS];
+		unsigned _in_flight         = 0;
+		unsigned _slot_waiters      = 0;
+		unsigned _idle_waiters      = 0;
+		bool     _completion_thread = false;
+
+		Genode::Semaphore _slot_released;
+		Genode::Semaphore _idle;
+
+		static void *_completion_entry(void *arg)
+		{
+			static_cast<Backend *>(arg)->_complete_requests();
+			return nullptr;
+		}
+
+		void _complete_requests()
+		{
+			/* the thread needs an LWP of its own to call into the rump kernel */
+			_rump_upcalls.hyp_schedule();
+			_rump_upcalls.hyp_lwproc_newlwp(0);
+			_rump_upcalls.hyp_unschedule();
+
+			for (;;) {
+				using namespace Block;
+
+				Packet_descriptor const packet = _session.tx()->get_acked_packet();
+
+				Request request;
+				{
+					Genode::Lock::Guard guard(_session_lock);
+
+					for (unsigned i = 0; i < MAX_REQUESTS; i++) {
+						Request &r = _requests[i];
+						if (!r.in_use || r.packet.offset() != packet.offset())
+							continue;
+
+						request  = r;
+						r.in_use = false;
+						break;
+					}
+				}
+
+				if (!request.in_use) {
+					Genode::error("I/O back end: unexpected acknowledgement");
+					continue;
+				}
+
+				bool const succeeded = packet.succeeded();
+
+				/* in packet */
+				if (packet.operation() == Packet_descriptor::READ && succeeded)
+					Genode::memcpy(request.data, _session.tx()->packet_content(packet),
+					               request.length);
+
+				{
+					Genode::Lock::Guard guard(_session_lock);
+					_session.tx()->release_packet(packet);
+
+					if (_slot_waiters) {
+						_slot_waiters--;
+						_slot_released.up();
+					}
+				}
+
+				/* sync request */
+				if (request.op & RUMPUSER_BIO_SYNC)
+					_session.sync();
+
+				if (request.biodone) {
+					_rump_upcalls.hyp_schedule();
+					request.biodone(request.donearg, request.length,
+					                succeeded ? 0 : EIO);
+					_rump_upcalls.hyp_unschedule();
+				}
+
+				Genode::Lock::Guard guard(_session_lock);
+				_in_flight--;
+
+				if (_in_flight == 0)
+					for (; _idle_waiters; _idle_waiters--)
+						_idle.up();
+			}
+		}
+
+		/**
+		 * Return free request slot along with an allocated packet
+		 *
+		 * Must be called with '_session_lock' held. Returns nullptr if
+		 * either no slot or no packet is available.
+		 */
+		Request *_alloc_request(Block::Packet_descriptor::Opcode opcode,
+		                        int64_t offset, size_t length)
+		{
+			using namespace Block;
+
+			Request *request = nullptr;
+			for (unsigned i = 0; i < MAX_REQUESTS && !request; i++)
+				if (!_requests[i].in_use)
+					request = &_requests[i];
+
+			if (!request)
+				return nullptr;
+
+			try {
+				request->packet = Packet_descriptor(_session.dma_alloc_packet(length),
+				                                    opcode, offset / _blk_size,
+				                                    length / _blk_size);
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return nullptr; }
+
+			request->in_use = true;
+			return request;
+		}
+
 	public:
 
 		Backend()
@@ -52,53 +192,77 @@ class Backend
 			return _blk_ops.supported(Block::Packet_descriptor::WRITE);
 		}
 
+		/**
+		 * Wait for the completion of all requests in flight and sync device
+		 */
 		void sync()
 		{
-			Genode::Lock::Guard guard(_session_lock);
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_session_lock);
+					if (_in_flight == 0)
+						break;
+
+					_idle_waiters++;
+				}
+				_idle.down();
+			}
 			_session.sync();
 		}
 
-		bool submit(int op, int64_t offset, size_t length, void *data)
+		/**
+		 * Issue block request
+		 *
+		 * The request is completed asynchronously by calling 'biodone'.
+		 *
+		 * \return false if the request could not be issued
+		 */
+		bool submit(int op, int64_t offset, size_t length, void *data,
+		            rump_biodone_fn biodone, void *donearg)
 		{
 			using namespace Block;
 
-			Genode::Lock::Guard guard(_session_lock);
+			if (length > TX_BUF_SIZE) {
+				Genode::error("I/O back end: request of ", length, " bytes "
+				              "exceeds packet buffer");
+				return false;
+			}
 
 			Packet_descriptor::Opcode opcode;
 			opcode = op & RUMPUSER_BIO_WRITE ? Packet_descriptor::WRITE :
 			                                   Packet_descriptor::READ;
-			/* allocate packet */
-			try {
-				Packet_descriptor packet( _session.dma_alloc_packet(length),
-				                         opcode, offset / _blk_size,
-				                         length / _blk_size);
 
-				/* out packet -> copy data */
-				if (opcode == Packet_descriptor::WRITE)
-					Genode::memcpy(_session.tx()->packet_content(packet), data, length);
+			Genode::Lock::Guard guard(_session_lock);
 
-				_session.tx()->submit_packet(packet);
-			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-				Genode::error("I/O back end: Packet allocation failed!");
-				return false;
+			if (!_completion_thread) {
+				rumpuser_thread_create(_completion_entry, this, "rump_bio",
+				                       0, 0, -1, nullptr);
+				_completion_thread = true;
 			}
 
-			/* wait and process result */
-			Packet_descriptor packet = _session.tx()->get_acked_packet();
-
-			/* in packet */
-			if (opcode == Packet_descriptor::READ)
-				Genode::memcpy(data, _session.tx()->packet_content(packet), length);
+			/* wait for the completion of requests if all resources are in use */
+			Request *request = nullptr;
+			while (!(request = _alloc_request(opcode, offset, length))) {
+				_slot_waiters++;
+				_session_lock.unlock();
+				_slot_released.down();
+				_session_lock.lock();
+			}
 
-			bool succeeded = packet.succeeded();
-			_session.tx()->release_packet(packet);
+			request->op      = op;
+			request->data    = data;
+			request->length  = length;
+			request->biodone = biodone;
+			request->donearg = donearg;
 
-			/* sync request */
-			if (op & RUMPUSER_BIO_SYNC) {
-				_session.sync();
-			}
+			/* out packet -> copy data */
+			if (opcode == Packet_descriptor::WRITE)
+				Genode::memcpy(_session.tx()->packet_content(request->packet),
+				               data, length);
 
-			return succeeded;
+			_in_flight++;
+			_session.tx()->submit_packet(request->packet);
+			return true;
 		}
 };
 
@@ -154,12 +318,12 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 		            "bio ",   donearg, " "
 		            "sync: ", !!(op & RUMPUSER_BIO_SYNC));
 
-	bool succeeded = backend().submit(op, off, dlen, data);
+	bool const submitted = backend().submit(op, off, dlen, data, biodone, donearg);
 
 	rumpkern_sched(nlocks, 0);
 
-	if (biodone)
-		biodone(donearg, dlen, succeeded ? 0 : EIO);
+	if (!submitted && biodone)
+		biodone(donearg, 0, EIO);
 }
 
 
@@ -121,13 +121,17 @@ struct Nitpicker_buffer
 		fn(pixel, alpha);
 	}
 
-	void reset_surface()
+	/**
+	 * Reset the back buffer within the area 'rect'
+	 */
+	void reset_surface(Rect rect)
 	{
-		Pixel_surface pixel(pixel_surface_ds.local_addr<Pixel_rgb888>(), size());
-		Alpha_surface alpha(alpha_surface_ds.local_addr<Pixel_alpha8>(), size());
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
 
-		Genode::size_t const num_pixels = size().count();
-		Genode::memset(alpha.addr(), 0, num_pixels);
+		Pixel_rgb888 * const pixel_base = pixel_surface_ds.local_addr<Pixel_rgb888>();
+		Pixel_alpha8 * const alpha_base = alpha_surface_ds.local_addr<Pixel_alpha8>();
 
 		/*
 		 * Initialize color buffer with 50% gray
@@ -135,14 +139,24 @@ struct Nitpicker_buffer
 		 * We do not use black to limit the bleeding of black into antialiased
 		 * drawing operations applied onto an initially transparent background.
 		 */
-		Pixel_rgb888 *dst = pixel.addr();
-
 		Pixel_rgb888 const gray(127, 127, 127, 255);
 
-		for (unsigned n = num_pixels; n; n--)
-			*dst++ = gray;
+		unsigned const line_len = size().w();
+
+		for (int y = rect.y1(); y <= rect.y2(); y++) {
+
+			Genode::size_t const offset = line_len*y + rect.x1();
+
+			Genode::memset(alpha_base + offset, 0, rect.w());
+
+			Pixel_rgb888 *dst = pixel_base + offset;
+			for (unsigned n = rect.w(); n; n--)
+				*dst++ = gray;
+		}
 	}
 
+	void reset_surface() { reset_surface(Rect(Point(0, 0), size())); }
+
 	template <typename DST_PT, typename SRC_PT>
 	void _convert_back_to_front(DST_PT                        *front_base,
 	                            Genode::Texture<SRC_PT> const &texture,
@@ -155,18 +169,16 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture, Point());
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
+		unsigned const line_len   = size().w();
 
 		unsigned char * const alpha_base = fb_ds.local_addr<unsigned char>()
 		                                 + mode.bytes_per_pixel()*num_pixels;
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
-
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
 		 * given threshold. The threshold is defines such that typical
@@ -174,30 +186,46 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (int y = rect.y1(); y <= rect.y2(); y++) {
+
+			Genode::size_t const offset = line_len*y + rect.x1();
+
+			unsigned char const *src = alpha_base + offset;
+			unsigned char       *dst = input_base + offset;
+
+			for (unsigned i = rect.w(); i; i--)
+				*dst++ = (*src++) > threshold;
+		}
 	}
 
-	void flush_surface()
+	/**
+	 * Transfer the back buffer within the area 'rect' to the nitpicker buffer
+	 *
+	 * The caller is responsible for calling 'refresh' for the area.
+	 */
+	void flush_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
 
-		_convert_back_to_front(pixel_base, texture, clip_rect);
-		_convert_back_to_front(alpha_base, texture, clip_rect);
+		_convert_back_to_front(pixel_base, texture, rect);
+		_convert_back_to_front(alpha_base, texture, rect);
 
-		_update_input_mask();
+		_update_input_mask(rect);
 	}
+
+	void flush_surface() { flush_surface(Rect(Point(0, 0), size())); }
 };
 
 #endif /* _INCLUDE__GEMS__NITPICKER_BUFFER_H_ */
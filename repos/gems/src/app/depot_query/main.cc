@@ -16,6 +16,8 @@
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
 #include <os/reporter.h>
+#include <util/avl_string.h>
+#include <util/list.h>
 #include <gems/vfs.h>
 #include <depot/archive.h>
 
@@ -23,6 +25,7 @@ namespace Depot_query {
 	using namespace Depot;
 	struct Recursion_limit;
 	struct Dependencies;
+	class  Pkg_index;
 	struct Main;
 }
 
@@ -144,6 +147,248 @@ class Depot_query::Dependencies
 };
 
 
+/**
+ * In-memory index of the pkg archives of the depot
+ *
+ * Depot archives are never modified once published because each version is
+ * stored at a distinct path. Hence, the content of the 'archives' and
+ * 'runtime' files of a pkg can be kept across config updates instead of
+ * being re-read from the VFS for each query. An index entry is dropped as
+ * soon as the pkg directory vanishes, e.g., after the depot was cleaned up,
+ * or if the index exceeds 'MAX_PKGS' entries.
+ *
+ * The queries traverse the index recursively. While a traversal is in
+ * progress, dropped entries are kept alive until the outermost traversal
+ * is finished.
+ */
+class Depot_query::Pkg_index : Noncopyable
+{
+	private:
+
+		enum { MAX_PKGS = 256 };
+
+		/*
+		 * The path is held by a base class to have it constructed before
+		 * the 'Avl_string_base' that refers to it
+		 */
+		struct Pkg_path
+		{
+			Archive::Path const _path;
+
+			Pkg_path(Archive::Path const &path) : _path(path) { }
+		};
+
+		class Pkg : private Pkg_path, public Avl_string_base,
+		            public List<Pkg>::Element, Noncopyable
+		{
+			private:
+
+				Allocator &_alloc;
+
+				unsigned       _num_archives = 0;
+				Archive::Path *_archives     = nullptr;
+
+				char  *_runtime      = nullptr;
+				size_t _runtime_size = 0;
+
+			public:
+
+				/**
+				 * Constructor
+				 *
+				 * \throw Directory::Nonexistent_directory
+				 * \throw Directory::Nonexistent_file
+				 * \throw File::Truncated_during_read
+				 */
+				Pkg(Allocator &alloc, Directory &depot, Archive::Path const &path)
+				:
+					Pkg_path(path), Avl_string_base(_path.string()), _alloc(alloc)
+				{
+					File_content archives(_alloc, Directory(depot, path),
+					                      "archives", File_content::Limit{16*1024});
+
+					archives.for_each_line<Archive::Path>([&] (Archive::Path const &) {
+						_num_archives++; });
+
+					if (_num_archives == 0)
+						return;
+
+					_archives = (Archive::Path *)
+						_alloc.alloc(_num_archives*sizeof(Archive::Path));
+
+					unsigned i = 0;
+					archives.for_each_line<Archive::Path>([&] (Archive::Path const &path) {
+						construct_at<Archive::Path>(&_archives[i++], path); });
+				}
+
+				~Pkg()
+				{
+					if (_archives)
+						_alloc.free(_archives, _num_archives*sizeof(Archive::Path));
+
+					if (_runtime)
+						_alloc.free(_runtime, _runtime_size);
+				}
+
+				template <typename FN>
+				void for_each_archive(FN const &fn) const
+				{
+					for (unsigned i = 0; i < _num_archives; i++)
+						fn(_archives[i]);
+				}
+
+				/**
+				 * Call 'fn' with the content of the pkg's 'runtime' file
+				 *
+				 * The file is read on the first call only.
+				 *
+				 * \throw Directory::Nonexistent_directory
+				 * \throw Directory::Nonexistent_file
+				 * \throw File::Truncated_during_read
+				 */
+				template <typename FN>
+				void with_runtime(Directory &depot, FN const &fn)
+				{
+					if (!_runtime) {
+						File_content runtime(_alloc, Directory(depot, _path),
+						                     "runtime", File_content::Limit{16*1024});
+
+						runtime.xml([&] (Xml_node node) {
+							_runtime_size = node.size();
+							_runtime = (char *)_alloc.alloc(_runtime_size);
+							memcpy(_runtime, node.addr(), _runtime_size);
+						});
+					}
+
+					try { fn(Xml_node(_runtime, _runtime_size)); }
+					catch (Xml_node::Invalid_syntax) { fn(Xml_node("<empty/>")); }
+				}
+		};
+
+		Allocator &_alloc;
+		Directory &_depot;
+
+		Avl_tree<Avl_string_base> _pkgs     { };
+		unsigned                  _num_pkgs { 0 };
+
+		/* entries dropped during a traversal */
+		List<Pkg> _stale { };
+
+		unsigned _traversals = 0;
+
+		/**
+		 * Guard for the duration of a traversal of a pkg
+		 */
+		struct Traversal : Noncopyable
+		{
+			Pkg_index &_index;
+
+			Traversal(Pkg_index &index) : _index(index) { _index._traversals++; }
+
+			~Traversal()
+			{
+				if (--_index._traversals > 0)
+					return;
+
+				while (Pkg *pkg = _index._stale.first()) {
+					_index._stale.remove(pkg);
+					destroy(_index._alloc, pkg);
+				}
+			}
+		};
+
+		/**
+		 * Drop entry from the index
+		 *
+		 * The entry may still be referenced by an outer traversal, which
+		 * defers its destruction.
+		 */
+		void _drop(Pkg &pkg)
+		{
+			_pkgs.remove(&pkg);
+			_num_pkgs--;
+
+			if (_traversals)
+				_stale.insert(&pkg);
+			else
+				destroy(_alloc, &pkg);
+		}
+
+		/**
+		 * Return index entry of pkg, read the pkg on the first access
+		 *
+		 * \throw Directory::Nonexistent_directory
+		 * \throw Directory::Nonexistent_file
+		 * \throw File::Truncated_during_read
+		 */
+		Pkg &_pkg(Archive::Path const &path)
+		{
+			Avl_string_base *node = _pkgs.first()
+			                      ? _pkgs.first()->find_by_name(path.string())
+			                      : nullptr;
+
+			Pkg *pkg = static_cast<Pkg *>(node);
+
+			if (!_depot.directory_exists(path)) {
+				if (pkg)
+					_drop(*pkg);
+				throw Directory::Nonexistent_directory();
+			}
+
+			if (!pkg) {
+				pkg = new (_alloc) Pkg(_alloc, _depot, path);
+
+				/* keep the index bounded, evicting an arbitrary entry */
+				if (_num_pkgs >= MAX_PKGS)
+					_drop(*static_cast<Pkg *>(_pkgs.first()));
+
+				_pkgs.insert(pkg);
+				_num_pkgs++;
+			}
+			return *pkg;
+		}
+
+	public:
+
+		Pkg_index(Allocator &alloc, Directory &depot)
+		: _alloc(alloc), _depot(depot) { }
+
+		~Pkg_index()
+		{
+			while (Avl_string_base *node = _pkgs.first())
+				_drop(*static_cast<Pkg *>(node));
+		}
+
+		/**
+		 * Call 'fn' for each archive listed in the 'archives' file of a pkg
+		 *
+		 * \throw Directory::Nonexistent_directory
+		 * \throw Directory::Nonexistent_file
+		 * \throw File::Truncated_during_read
+		 */
+		template <typename FN>
+		void for_each_archive(Archive::Path const &pkg, FN const &fn)
+		{
+			Traversal traversal(*this);
+			_pkg(pkg).for_each_archive(fn);
+		}
+
+		/**
+		 * Call 'fn' with the 'runtime' of a pkg as 'Xml_node' argument
+		 *
+		 * \throw Directory::Nonexistent_directory
+		 * \throw Directory::Nonexistent_file
+		 * \throw File::Truncated_during_read
+		 */
+		template <typename FN>
+		void with_runtime(Archive::Path const &pkg, FN const &fn)
+		{
+			Traversal traversal(*this);
+			_pkg(pkg).with_runtime(_depot, fn);
+		}
+};
+
+
 struct Depot_query::Main
 {
 	Env &_env;
@@ -156,6 +401,8 @@ struct Depot_query::Main
 
 	Directory _depot_dir { _root, "depot" };
 
+	Pkg_index _pkg_index { _heap, _depot_dir };
+
 	Signal_handler<Main> _config_handler {
 		_env.ep(), *this, &Main::_handle_config };
 
@@ -283,20 +530,14 @@ Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
                                     Rom_label       const &rom_label,
                                     Recursion_limit        recursion_limit)
 {
-	/*
-	 * \throw Directory::Nonexistent_directory
-	 */
-	Directory pkg_dir(_depot_dir, pkg_path);
+	Archive::Path result;
 
 	/*
+	 * \throw Directory::Nonexistent_directory
 	 * \throw Directory::Nonexistent_file
 	 * \throw File::Truncated_during_read
 	 */
-	File_content archives(_heap, pkg_dir, "archives", File_content::Limit{16*1024});
-
-	Archive::Path result;
-
-	archives.for_each_line<Archive::Path>([&] (Archive::Path const &archive_path) {
+	_pkg_index.for_each_archive(pkg_path, [&] (Archive::Path const &archive_path) {
 
 		if (result.valid())
 			return;
@@ -333,11 +574,7 @@ Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
 
 void Depot_query::Main::_query_blueprint(Directory::Path const &pkg_path, Xml_generator &xml)
 {
-	Directory pkg_dir(_root, Directory::Path("depot/", pkg_path));
-
-	File_content runtime(_heap, pkg_dir, "runtime", File_content::Limit{16*1024});
-
-	runtime.xml([&] (Xml_node node) {
+	_pkg_index.with_runtime(pkg_path, [&] (Xml_node node) {
 
 		xml.node("pkg", [&] () {
 
@@ -410,10 +647,7 @@ void Depot_query::Main::_collect_source_dependencies(Archive::Path const &path,
 
 	case Archive::PKG:
 		try {
-			File_content archives(_heap, Directory(_depot_dir, path),
-			                      "archives", File_content::Limit{16*1024});
-
-			archives.for_each_line<Archive::Path>([&] (Archive::Path const &path) {
+			_pkg_index.for_each_archive(path, [&] (Archive::Path const &path) {
 				_collect_source_dependencies(path, dependencies, recursion_limit); });
 		}
 		catch (File_content::Nonexistent_file) { }
@@ -454,10 +688,7 @@ void Depot_query::Main::_collect_binary_dependencies(Archive::Path const &path,
 		try {
 			dependencies.record(path);
 
-			File_content archives(_heap, Directory(_depot_dir, path),
-			                      "archives", File_content::Limit{16*1024});
-
-			archives.for_each_line<Archive::Path>([&] (Archive::Path const &archive_path) {
+			_pkg_index.for_each_archive(path, [&] (Archive::Path const &archive_path) {
 				_collect_binary_dependencies(archive_path, dependencies, recursion_limit); });
 
 		} catch (File_content::Nonexistent_file) { }
@@ -154,6 +154,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	{
 		blend.animate();
 
+		_mark_look_as_changed();
+
 		animated(blend != blend.dst());
 	}
 };
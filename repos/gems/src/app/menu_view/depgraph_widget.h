@@ -660,6 +660,16 @@ struct Menu_view::Depgraph_widget : Widget
 		for (Widget *w = _children.first(); w; w = w->next())
 			w->size(w->geometry().area());
 	}
+
+	/* the connections are drawn between the child widgets */
+	bool _draws_across_children() const override { return true; }
+
+	Rect _draw_area(Point at) const override
+	{
+		/* account for the shadow of the connections */
+		Rect const area = Widget::_draw_area(at);
+		return Rect(area.p1(), area.p2() + Point(0, 1));
+	}
 };
 
 #endif /* _DEPGRAPH_WIDGET_H_ */
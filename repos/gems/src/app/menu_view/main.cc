@@ -25,6 +25,7 @@
 #include <input/event.h>
 #include <os/reporter.h>
 #include <timer_session/connection.h>
+#include <util/dirty_rect.h>
 
 /* gems includes */
 #include <gems/nitpicker_buffer.h>
@@ -138,6 +139,11 @@ struct Menu_view::Main
 	 */
 	unsigned _frame_cnt = 0;
 
+	/**
+	 * Areas of the widget tree to redraw
+	 */
+	Dirty_rect<Rect, 3> _dirty { };
+
 	Main(Env &env) : _env(env)
 	{
 		_dialog_rom.sigh(_dialog_update_handler);
@@ -164,7 +170,7 @@ void Menu_view::Main::_handle_dialog_update()
 	try {
 		Xml_node dialog_xml(_dialog_rom.local_addr<char>());
 
-		_root_widget.update(dialog_xml);
+		_root_widget.apply(dialog_xml);
 		_root_widget.size(_root_widget.min_size());
 	} catch (...) {
 		Genode::error("failed to construct widget tree");
@@ -269,23 +275,42 @@ void Menu_view::Main::_handle_frame_timer()
 		Area const old_size = _buffer.constructed() ? _buffer->size() : Area();
 		Area const size     = _root_widget.min_size();
 
-		if (!_buffer.constructed() || size.w() > old_size.w() || size.h() > old_size.h())
+		bool const full_redraw = !_buffer.constructed()
+		                      || size.w() > old_size.w()
+		                      || size.h() > old_size.h();
+
+		if (full_redraw)
 			_buffer.construct(_nitpicker, size, _env.ram(), _env.rm());
-		else
-			_buffer->reset_surface();
 
 		_root_widget.size(size);
 		_root_widget.position(Point(0, 0));
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
-		                               Surface<Pixel_alpha8> &alpha) {
-			_root_widget.draw(pixel, alpha, Point(0, 0));
+		/* determine the parts of the widget tree that changed */
+		_root_widget.mark_damaged(_dirty, Point(0, 0));
+
+		if (full_redraw)
+			_dirty.mark_as_dirty(Rect(Point(0, 0), _buffer->size()));
+
+		/* redraw and refresh the dirty areas only */
+		_dirty.flush([&] (Rect const &dirty) {
+
+			Rect const rect = Rect::intersect(dirty, Rect(Point(0, 0), _buffer->size()));
+			if (!rect.valid())
+				return;
+
+			_buffer->reset_surface(rect);
+
+			_buffer->apply_to_surface([&] (Surface<Pixel_rgb888> &pixel,
+			                               Surface<Pixel_alpha8> &alpha) {
+				pixel.clip(rect);
+				alpha.clip(rect);
+				_root_widget.draw(pixel, alpha, Point(0, 0));
+			});
+
+			_buffer->flush_surface(rect);
+			_nitpicker.framebuffer()->refresh(rect.x1(), rect.y1(), rect.w(), rect.h());
 		});
 
-		_buffer->flush_surface();
-		_nitpicker.framebuffer()->refresh(0, 0, _buffer->size().w(), _buffer->size().h());
 		_update_view();
 
 		_schedule_redraw = false;
@@ -95,6 +95,52 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/**
+		 * Checksum over a range of XML text
+		 *
+		 * The checksum is used to detect unchanged XML nodes between
+		 * consecutive dialog updates without keeping a copy of the old
+		 * dialog.
+		 */
+		struct Checksum
+		{
+			unsigned long value = 0;
+			size_t        len   = 0;
+
+			Checksum() { }
+
+			Checksum(char const *s, size_t len) : len(len)
+			{
+				/* FNV-1a */
+				value = 2166136261UL;
+				for (size_t i = 0; i < len; i++)
+					value = (value ^ (unsigned char)s[i])*16777619UL;
+			}
+
+			bool operator == (Checksum const &other) const {
+				return other.value == value && other.len == len; }
+		};
+
+		Checksum _node_checksum { };   /* complete XML node */
+		Checksum _look_checksum { };   /* XML input of the widget's own look */
+
+		/*
+		 * Flag indicating that the widget's own look changed since the last
+		 * call of 'mark_damaged'
+		 */
+		bool _look_changed = true;
+
+		/*
+		 * Screen area occupied by the widget when it was drawn the last time
+		 */
+		Rect _drawn_area { };
+
+		/*
+		 * Compound of the areas of removed child widgets that still need to
+		 * be redrawn
+		 */
+		Rect _vanished_area { };
+
 	protected:
 
 		Widget_factory &_factory;
@@ -104,10 +150,20 @@ class Menu_view::Widget : public List<Widget>::Element
 		struct Model_update_policy : List_model_update_policy<Widget>
 		{
 			Widget_factory &_factory;
+			Rect           &_vanished_area;
 
-			Model_update_policy(Widget_factory &factory) : _factory(factory) { }
+			Model_update_policy(Widget_factory &factory, Rect &vanished_area)
+			: _factory(factory), _vanished_area(vanished_area) { }
 
-			void destroy_element(Widget &w) { _factory.destroy(&w); }
+			void destroy_element(Widget &w)
+			{
+				Rect const area = w._drawn_area;
+				if (area.valid())
+					_vanished_area = _vanished_area.valid()
+					               ? Rect::compound(_vanished_area, area) : area;
+
+				_factory.destroy(&w);
+			}
 
 			Widget &create_element(Xml_node elem_node)
 			{
@@ -117,7 +173,7 @@ class Menu_view::Widget : public List<Widget>::Element
 				throw Unknown_element_type();
 			}
 
-			void update_element(Widget &w, Xml_node node) { w.update(node); }
+			void update_element(Widget &w, Xml_node node) { w.apply(node); }
 
 			static bool element_matches_xml_node(Widget const &w, Xml_node node)
 			{
@@ -125,7 +181,7 @@ class Menu_view::Widget : public List<Widget>::Element
 				    && Widget::node_name(node) == w._name;
 			}
 
-		} _model_update_policy { _factory };
+		} _model_update_policy { _factory, _vanished_area };
 
 		inline void _update_children(Xml_node node)
 		{
@@ -136,12 +192,47 @@ class Menu_view::Widget : public List<Widget>::Element
 		                    Surface<Pixel_alpha8> &alpha_surface,
 		                    Point at) const
 		{
-			for (Widget const *w = _children.first(); w; w = w->next())
-				w->draw(pixel_surface, alpha_surface, at + w->_animated_geometry.p1());
+			Rect const clip = pixel_surface.clip();
+
+			for (Widget const *w = _children.first(); w; w = w->next()) {
+
+				Point const child_at = at + w->_animated_geometry.p1();
+
+				/* skip children outside the area to redraw */
+				if (!Rect::intersect(clip, w->_draw_area(child_at)).valid())
+					continue;
+
+				w->draw(pixel_surface, alpha_surface, child_at);
+			}
 		}
 
 		virtual void _layout() { }
 
+		/**
+		 * Return screen area touched when drawing the widget at 'at'
+		 */
+		virtual Rect _draw_area(Point at) const
+		{
+			Area const animated_area = _animated_geometry.area();
+
+			return Rect(at, Area(max(animated_area.w(), _geometry.w()),
+			                     max(animated_area.h(), _geometry.h())));
+		}
+
+		/**
+		 * Return true if the widget paints across the area of its children
+		 *
+		 * The look of such a widget depends on its sub nodes and the
+		 * placement of its children. Hence, it is redrawn as a whole whenever
+		 * one of its children changes.
+		 */
+		virtual bool _draws_across_children() const { return false; }
+
+		/**
+		 * Mark widget to be redrawn, e.g., during an animation
+		 */
+		void _mark_look_as_changed() { _look_changed = true; }
+
 		Rect _inner_geometry() const
 		{
 			return Rect(Point(margin.left, margin.top),
@@ -202,6 +293,81 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		virtual void update(Xml_node node) = 0;
 
+		/**
+		 * Update widget from XML node unless the node remained unchanged
+		 */
+		void apply(Xml_node node)
+		{
+			Checksum const node_checksum(node.addr(), node.size());
+
+			if (node_checksum == _node_checksum)
+				return;
+
+			_node_checksum = node_checksum;
+
+			/* by default, only the attributes define the look of a widget */
+			Checksum const look_checksum = _draws_across_children()
+			                             ? node_checksum
+			                             : Checksum(node.addr(), node.content_base()
+			                                                   - node.addr());
+			if (!(look_checksum == _look_checksum)) {
+				_look_checksum = look_checksum;
+				_look_changed  = true;
+			}
+
+			update(node);
+		}
+
+		/**
+		 * Mark screen areas changed since the previous call as dirty
+		 *
+		 * \param dirty  dirty-rectangle tracker
+		 * \param at     absolute position of the widget
+		 * \param mark   if false, the damage is merely detected but the
+		 *               tracker is left untouched
+		 * \return       true if the widget or one of its children changed
+		 *
+		 * The function must be called once before each redraw. It records the
+		 * areas of the widget tree as drawn subsequently.
+		 */
+		template <typename DIRTY>
+		bool mark_damaged(DIRTY &dirty, Point at, bool mark = true)
+		{
+			Rect const area = _draw_area(at);
+
+			bool const damaged = _look_changed
+			                  || area.p1() != _drawn_area.p1()
+			                  || area.p2() != _drawn_area.p2();
+
+			auto mark_as_dirty = [&] (Rect rect) {
+				if (mark && rect.valid())
+					dirty.mark_as_dirty(rect); };
+
+			if (damaged) {
+				mark_as_dirty(_drawn_area);
+				mark_as_dirty(area);
+			}
+
+			mark_as_dirty(_vanished_area);
+			bool children_damaged = _vanished_area.valid();
+
+			bool const mark_children = mark && !_draws_across_children();
+
+			for (Widget *w = _children.first(); w; w = w->next())
+				if (w->mark_damaged(dirty, at + w->_animated_geometry.p1(),
+				                    mark_children))
+					children_damaged = true;
+
+			if (children_damaged && !mark_children)
+				mark_as_dirty(area);
+
+			_drawn_area    = area;
+			_vanished_area = Rect();
+			_look_changed  = false;
+
+			return damaged || children_damaged;
+		}
+
 		virtual Area min_size() const = 0;
 
 		virtual void draw(Surface<Pixel_rgb888> &pixel_surface,
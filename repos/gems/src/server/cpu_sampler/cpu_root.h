@@ -21,6 +21,7 @@
 #include "cpu_session_component.h"
 #include "cpu_thread_component.h"
 #include "thread_list_change_handler.h"
+#include "sample_output.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -36,6 +37,7 @@ class Cpu_sampler::Cpu_root : public Root_component<Cpu_session_component>
 		Allocator                  &_md_alloc;
 		Thread_list                &_thread_list;
 		Thread_list_change_handler &_thread_list_change_handler;
+		Sample_output              &_sample_output;
 
 	protected:
 
@@ -45,6 +47,7 @@ class Cpu_sampler::Cpu_root : public Root_component<Cpu_session_component>
 				new (md_alloc()) Cpu_session_component(_thread_ep, _env,
 				                                       _md_alloc, _thread_list,
 				                                       _thread_list_change_handler,
+				                                       _sample_output,
 				                                       args);
 			return cpu_session_component;
 		}
@@ -62,12 +65,14 @@ class Cpu_sampler::Cpu_root : public Root_component<Cpu_session_component>
 		         Env                        &env,
 		         Allocator                  &md_alloc,
 		         Thread_list                &thread_list,
-		         Thread_list_change_handler &thread_list_change_handler)
+		         Thread_list_change_handler &thread_list_change_handler,
+		         Sample_output              &sample_output)
 		: Root_component<Cpu_session_component>(&session_ep, &md_alloc),
 		  _thread_ep(thread_ep), _env(env),
 		  _md_alloc(md_alloc),
 		  _thread_list(thread_list),
-		  _thread_list_change_handler(thread_list_change_handler) { }
+		  _thread_list_change_handler(thread_list_change_handler),
+		  _sample_output(sample_output) { }
 
 };
 
@@ -96,6 +96,7 @@ Cpu_session_component(Rpc_entrypoint             &thread_ep,
                       Allocator                  &md_alloc,
                       Thread_list                &thread_list,
                       Thread_list_change_handler &thread_list_change_handler,
+                      Sample_output              &sample_output,
                       char                 const *args)
 : _thread_ep(thread_ep),
   _env(env),
@@ -104,6 +105,7 @@ Cpu_session_component(Rpc_entrypoint             &thread_ep,
   _md_alloc(md_alloc),
   _thread_list(thread_list),
   _thread_list_change_handler(thread_list_change_handler),
+  _sample_output(sample_output),
   _session_label(label_from_args(args)),
   _native_cpu_cap(_setup_native_cpu())
 { }
@@ -23,6 +23,7 @@
 /* local includes */
 #include "cpu_thread_component.h"
 #include "thread_list_change_handler.h"
+#include "sample_output.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -63,6 +64,7 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Allocator                               &_md_alloc;
 		Thread_list                             &_thread_list;
 		Thread_list_change_handler              &_thread_list_change_handler;
+		Sample_output                           &_sample_output;
 		Session_label                            _session_label;
 		unsigned int                             _next_thread_id = 0;
 		Capability<Cpu_session::Native_cpu>      _native_cpu_cap;
@@ -74,6 +76,7 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Session_label &session_label() { return _session_label; }
 		Cpu_session_client &parent_cpu_session() { return _parent_cpu_session; }
 		Rpc_entrypoint &thread_ep() { return _thread_ep; }
+		Sample_output &sample_output() { return _sample_output; }
 
 		/**
 		 * Constructor
@@ -83,6 +86,7 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		                      Allocator                  &md_alloc,
 		                      Thread_list                &thread_list,
 		                      Thread_list_change_handler &thread_list_change_handler,
+		                      Sample_output              &sample_output,
 		                      char                 const *args);
 
 		/**
@@ -34,6 +34,7 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 unsigned int             thread_id)
 : _cpu_session_component(cpu_session_component), _env(env),
   _md_alloc(md_alloc),
+  _thread_id(thread_id),
   _parent_cpu_thread(
       _cpu_session_component.parent_cpu_session().create_thread(pd,
                                                                 name,
@@ -109,6 +110,14 @@ void Cpu_sampler::Cpu_thread_component::flush()
 	if (_sample_buf_index == 0)
 		return;
 
+	Sample_output &output = _cpu_session_component.sample_output();
+
+	if (output.binary()) {
+		output.write(_label, _thread_id, _sample_buf, _sample_buf_index);
+		_sample_buf_index = 0;
+		return;
+	}
+
 	if (!_log.constructed())
 		_log.construct(_env, _log_session_label);
 
@@ -39,6 +39,8 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 
 		Allocator             &_md_alloc;
 
+		unsigned int const     _thread_id;
+
 		Cpu_thread_client      _parent_cpu_thread;
 
 		bool                   _started = false;
@@ -27,6 +27,7 @@
 #include "cpu_session_component.h"
 #include "cpu_thread_component.h"
 #include "thread_list_change_handler.h"
+#include "sample_output.h"
 
 namespace Cpu_sampler { struct Main; }
 
@@ -42,6 +43,7 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 {
 	Genode::Env            &env;
 	Genode::Heap            alloc;
+	Sample_output           sample_output;
 	Cpu_root                cpu_root;
 	Attached_rom_dataspace  config;
 	Timer::Connection       timer { env };
@@ -90,12 +92,19 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 		unsigned int sample_interval_ms =
 			config.xml().attribute_value<unsigned int>("sample_interval_ms", 1000);
 
+		/* a sample interval in microseconds takes precedence */
+		unsigned int sample_interval_us =
+			config.xml().attribute_value<unsigned int>("sample_interval_us",
+			                                           sample_interval_ms * 1000);
+
 		unsigned int sample_duration_s =
 			config.xml().attribute_value<unsigned int>("sample_duration_s", 10);
 
-		max_sample_index = ((sample_duration_s * 1000) / sample_interval_ms) - 1;
+		max_sample_index = ((sample_duration_s * 1000000ULL) / sample_interval_us) - 1;
+
+		timeout_us = sample_interval_us;
 
-		timeout_us = sample_interval_ms * 1000;
+		sample_output.apply_config(config.xml());
 
 		thread_list_changed();
 
@@ -167,7 +176,9 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	Main(Genode::Env &env)
 	: env(env),
 	  alloc(env.ram(), env.rm()),
-	  cpu_root(env.ep().rpc_ep(), env.ep().rpc_ep(), env, alloc, thread_list, *this),
+	  sample_output(env, alloc),
+	  cpu_root(env.ep().rpc_ep(), env.ep().rpc_ep(), env, alloc, thread_list,
+	           *this, sample_output),
 	  config(env, "config")
 	{
 		/*
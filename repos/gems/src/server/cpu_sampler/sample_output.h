@@ -0,0 +1,163 @@
+/*
+ * \brief  Binary output of sampled instruction pointers to a file system
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SAMPLE_OUTPUT_H_
+#define _SAMPLE_OUTPUT_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/session_label.h>
+#include <file_system_session/connection.h>
+#include <file_system/util.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	struct Sample_file_header;
+	class Sample_output;
+}
+
+
+/**
+ * Header at the start of each binary sample file
+ *
+ * The header is followed by the raw sampled instruction pointers, each
+ * 'addr_size' bytes in the byte order of the sampled machine.
+ */
+struct Cpu_sampler::Sample_file_header
+{
+	enum { VERSION = 1 };
+
+	char     magic[8]  = { 'G', 'S', 'A', 'M', 'P', 'L', 'E', 'S' };
+	uint32_t version   = VERSION;
+	uint32_t addr_size = sizeof(addr_t);
+
+} __attribute__((packed));
+
+
+/**
+ * Destination of the samples, selected via the 'output' config attribute
+ *
+ * By default, the samples are written as text to a LOG session per thread.
+ * With 'output="file_system"', the samples are appended in binary form to
+ * one file per thread at a File_system session. This avoids the formatting
+ * and the LOG round trip per sample and thereby allows for higher sampling
+ * rates.
+ */
+class Cpu_sampler::Sample_output
+{
+	private:
+
+		enum { TX_BUF_SIZE = 64*1024 };
+
+		Env       &_env;
+		Allocator &_alloc;
+
+		Allocator_avl _tx_alloc { &_alloc };
+
+		Constructible<File_system::Connection> _fs;
+
+		typedef String<File_system::MAX_NAME_LEN> File_name;
+
+		/**
+		 * Return file name for the samples of the specified thread
+		 *
+		 * The label elements are separated by dots, e.g., the samples of the
+		 * thread "init -> test -> ep" with ID 1 are written to
+		 * "init.test.ep.1.samples".
+		 */
+		static File_name _file_name(Session_label const &label, unsigned thread_id)
+		{
+			char buf[File_name::capacity()];
+
+			char const *src = label.string();
+			size_t      i   = 0;
+
+			for (; *src && i < sizeof(buf) - 1; src++) {
+
+				if (!strcmp(src, " -> ", 4)) {
+					buf[i++] = '.';
+					src += 3;
+					continue;
+				}
+
+				buf[i++] = (*src == '/') ? '_' : *src;
+			}
+			buf[i] = 0;
+
+			return File_name(Cstring(buf), ".", thread_id, ".samples");
+		}
+
+	public:
+
+		Sample_output(Env &env, Allocator &alloc) : _env(env), _alloc(alloc) { }
+
+		void apply_config(Xml_node config)
+		{
+			typedef String<16> Output;
+			Output const output = config.attribute_value("output", Output("log"));
+
+			if (output == "file_system") {
+				if (!_fs.constructed())
+					_fs.construct(_env, _tx_alloc, "samples", "/", true, TX_BUF_SIZE);
+			} else {
+				_fs.destruct();
+			}
+		}
+
+		bool binary() const { return _fs.constructed(); }
+
+		/**
+		 * Append samples to the binary sample file of a thread
+		 *
+		 * The file is created with a 'Sample_file_header' on the first
+		 * write.
+		 */
+		void write(Session_label const &label, unsigned thread_id,
+		           addr_t const *samples, unsigned num_samples)
+		{
+			using namespace File_system;
+
+			if (!_fs.constructed())
+				return;
+
+			File_name const name = _file_name(label, thread_id);
+
+			try {
+				Dir_handle   dir_handle = _fs->dir("/", false);
+				Handle_guard dir_guard(*_fs, dir_handle);
+
+				Constructible<File_handle> handle;
+				try {
+					handle.construct(_fs->file(dir_handle, name.string(),
+					                           WRITE_ONLY, false));
+				}
+				catch (Lookup_failed) {
+					handle.construct(_fs->file(dir_handle, name.string(),
+					                           WRITE_ONLY, true));
+
+					Sample_file_header const header;
+					File_system::write(*_fs, *handle, &header, sizeof(header), 0);
+				}
+				Handle_guard file_guard(*_fs, *handle);
+
+				File_system::write(*_fs, *handle, samples,
+				                   num_samples*sizeof(addr_t), SEEK_TAIL);
+			}
+			catch (...) {
+				error("could not write samples to file '", name, "'"); }
+		}
+};
+
+#endif /* _SAMPLE_OUTPUT_H_ */
@@ -174,65 +174,307 @@ inline void draw_glyph(Color                fg_color,
 }
 
 
+/**
+ * Cache of glyphs pre-rendered for the color combinations in use
+ *
+ * Terminal output typically uses only a few combinations of foreground and
+ * background colors. For each combination, the cache holds an atlas with the
+ * cell-sized pixel representation of the glyphs, which are rendered on first
+ * use. If all atlases are in use, the least recently used one is recycled.
+ */
 template <typename PT>
-static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
-                                         PT                    *fb_base,
-                                         unsigned               fb_width,
-                                         unsigned               fb_height,
-                                         Font_family const     &font_family)
+class Glyph_cache
 {
-	Font const &regular_font = *font_family.font(Font_face::REGULAR);
-	unsigned glyph_height = regular_font.img_h,
-	         glyph_step_x = regular_font.wtab['m'];
+	private:
 
-	unsigned y = 0;
-	for (unsigned line = 0; line < cell_array->num_lines(); line++) {
+		enum { NUM_ATLASES = 4, NUM_GLYPHS = 256 };
 
-		if (cell_array->line_dirty(line)) {
+		struct Atlas
+		{
+			Color    fg, bg;
+			bool     used     = false;
+			unsigned last_use = 0;
+			bool     rendered[NUM_GLYPHS];
+			PT      *pixels   = nullptr;
+		};
 
-			if (verbose)
-				Genode::log("convert line ", line);
+		Genode::Allocator &_alloc;
 
-			unsigned x = 0;
-			for (unsigned column = 0; column < cell_array->num_cols(); column++) {
+		Font const &_font;
 
-				Char_cell      cell  = cell_array->get_cell(column, line);
-				Font const    *font  = font_family.font(cell.font_face());
-				unsigned char  ascii = cell.ascii;
+		unsigned const _cell_width;
+		unsigned const _cell_height;
 
-				if (ascii == 0)
-					ascii = ' ';
+		Genode::size_t const _atlas_size =
+			NUM_GLYPHS*_cell_width*_cell_height*sizeof(PT);
 
-				unsigned char const *glyph_base  = font->img + font->otab[ascii];
+		Atlas _atlases[NUM_ATLASES];
 
-				unsigned glyph_width = regular_font.wtab[ascii];
+		unsigned _use_cnt = 0;
 
-				if (x + glyph_width > fb_width)	break;
+		Atlas &_atlas(Color fg, Color bg)
+		{
+			Atlas *victim = &_atlases[0];
 
-				Color fg_color = foreground_color(cell);
-				Color bg_color = background_color(cell);
+			for (Atlas &atlas : _atlases) {
 
-				if (cell.has_cursor()) {
-					fg_color = Color( 63,  63,  63);
-					bg_color = Color(255, 255, 255);
+				if (atlas.used && atlas.fg == fg && atlas.bg == bg) {
+					atlas.last_use = ++_use_cnt;
+					return atlas;
 				}
 
-				draw_glyph<PT>(fg_color, bg_color,
-				               glyph_base, glyph_width,
-				               (unsigned)font->img_w, (unsigned)font->img_h,
-				               glyph_step_x, fb_base + x, fb_width);
+				/* prefer unused atlases over the least recently used one */
+				if (victim->used && (!atlas.used || atlas.last_use < victim->last_use))
+					victim = &atlas;
+			}
+
+			victim->fg       = fg;
+			victim->bg       = bg;
+			victim->used     = true;
+			victim->last_use = ++_use_cnt;
+
+			for (bool &rendered : victim->rendered)
+				rendered = false;
+
+			return *victim;
+		}
+
+	public:
+
+		Glyph_cache(Genode::Allocator &alloc, Font_family const &font_family)
+		:
+			_alloc(alloc), _font(*font_family.font(Font_face::REGULAR)),
+			_cell_width(_font.wtab['m']), _cell_height(_font.img_h)
+		{
+			for (Atlas &atlas : _atlases)
+				atlas.pixels = (PT *)_alloc.alloc(_atlas_size);
+		}
+
+		~Glyph_cache()
+		{
+			for (Atlas &atlas : _atlases)
+				_alloc.free(atlas.pixels, _atlas_size);
+		}
+
+		unsigned cell_width()  const { return _cell_width; }
+		unsigned cell_height() const { return _cell_height; }
+
+		/**
+		 * Return pixels of glyph, rendered as a cell of 'cell_width' x
+		 * 'cell_height' pixels
+		 */
+		PT const *glyph(unsigned char ascii, Color fg, Color bg)
+		{
+			Atlas &atlas = _atlas(fg, bg);
+
+			PT * const pixels = atlas.pixels + ascii*_cell_width*_cell_height;
+
+			if (!atlas.rendered[ascii]) {
+
+				unsigned const glyph_width = Genode::min((unsigned)_font.wtab[ascii],
+				                                         _cell_width);
+
+				draw_glyph<PT>(fg, bg, _font.img + _font.otab[ascii], glyph_width,
+				               (unsigned)_font.img_w, _cell_height,
+				               _cell_width, pixels, _cell_width);
 
-				x += glyph_step_x;
+				atlas.rendered[ascii] = true;
 			}
+			return pixels;
 		}
-		y       += glyph_height;
-		fb_base += fb_width*glyph_height;
+};
 
-		if (y + glyph_height > fb_height) break;
-	}
+
+/**
+ * Return true if two character cells look the same
+ */
+static inline bool same_look(Char_cell const &c1, Char_cell const &c2)
+{
+	return c1.attr == c2.attr && c1.ascii == c2.ascii && c1.color == c2.color;
 }
 
 
+/**
+ * Pixel representation of a cell array
+ *
+ * The screen keeps a copy of the character cells as currently visible in
+ * the framebuffer. When converting the cell array to pixels, only the cells
+ * that differ from this copy are drawn. Scrolled content is moved within
+ * the framebuffer instead of being redrawn.
+ */
+template <typename PT>
+class Pixel_screen
+{
+	private:
+
+		Genode::Allocator &_alloc;
+
+		Cell_array<Char_cell> &_cell_array;
+
+		unsigned const _num_cols  = _cell_array.num_cols();
+		unsigned const _num_lines = _cell_array.num_lines();
+
+		/* cells as currently drawn to the framebuffer */
+		Char_cell * const _drawn =
+			(Char_cell *)_alloc.alloc(_num_cols*_num_lines*sizeof(Char_cell));
+
+		Glyph_cache<PT> _glyph_cache;
+
+		PT      * const _fb_base;
+		unsigned const  _fb_width;
+		unsigned const  _fb_height;
+
+		/* number of lines and columns visible in the framebuffer */
+		unsigned const _visible_lines =
+			Genode::min(_num_lines, _fb_height/_glyph_cache.cell_height());
+		unsigned const _visible_cols =
+			Genode::min(_num_cols, _fb_width/_glyph_cache.cell_width());
+
+		Char_cell *_drawn_line(unsigned line) { return _drawn + line*_num_cols; }
+
+		/**
+		 * Move already rendered lines of a scrolled region
+		 *
+		 * \return  true if pixels were moved
+		 */
+		bool _scroll(int start, int end, int lines)
+		{
+			if (end >= (int)_visible_lines)
+				end = _visible_lines - 1;
+
+			int const num_lines = end - start + 1;
+			int const distance  = lines < 0 ? -lines : lines;
+
+			if (start < 0 || distance >= num_lines)
+				return false;
+
+			unsigned const from = lines > 0 ? start + distance : start;
+			unsigned const to   = lines > 0 ? start : start + distance;
+			unsigned const num  = num_lines - distance;
+
+			Genode::size_t const line_pixels = _fb_width*_glyph_cache.cell_height();
+
+			Genode::memmove(_fb_base + to*line_pixels, _fb_base + from*line_pixels,
+			                num*line_pixels*sizeof(PT));
+
+			Genode::memmove(_drawn_line(to), _drawn_line(from),
+			                num*_num_cols*sizeof(Char_cell));
+			return true;
+		}
+
+	public:
+
+		Pixel_screen(Genode::Allocator &alloc, Cell_array<Char_cell> &cell_array,
+		             Font_family const &font_family,
+		             PT *fb_base, unsigned fb_width, unsigned fb_height)
+		:
+			_alloc(alloc), _cell_array(cell_array),
+			_glyph_cache(alloc, font_family),
+			_fb_base(fb_base), _fb_width(fb_width), _fb_height(fb_height)
+		{
+			/* cells not drawn yet never look like any valid cell */
+			Char_cell undefined;
+			undefined.attr = 0xff;
+
+			for (unsigned i = 0; i < _num_cols*_num_lines; i++)
+				_drawn[i] = undefined;
+		}
+
+		~Pixel_screen()
+		{
+			_alloc.free(_drawn, _num_cols*_num_lines*sizeof(Char_cell));
+		}
+
+		/**
+		 * Update pixels of the dirty lines and mark the lines as clean
+		 *
+		 * \return  changed framebuffer area in pixels, or an invalid
+		 *          rectangle if nothing changed
+		 */
+		Genode::Surface_base::Rect convert()
+		{
+			typedef Genode::Surface_base::Rect  Rect;
+			typedef Genode::Surface_base::Point Point;
+
+			unsigned const cell_width  = _glyph_cache.cell_width();
+			unsigned const cell_height = _glyph_cache.cell_height();
+
+			int first_col  = _visible_cols,  last_col  = -1,
+			    first_line = _visible_lines, last_line = -1;
+
+			_cell_array.flush_scroll_hint([&] (int start, int end, int lines) {
+
+				if (!_scroll(start, end, lines))
+					return;
+
+				first_col  = 0;
+				last_col   = _visible_cols - 1;
+				first_line = Genode::min(first_line, start);
+				last_line  = Genode::min((int)_visible_lines - 1, end);
+			});
+
+			for (unsigned line = 0; line < _num_lines; line++) {
+
+				if (!_cell_array.line_dirty(line))
+					continue;
+
+				_cell_array.mark_line_as_clean(line);
+
+				if (line >= _visible_lines)
+					continue;
+
+				if (verbose)
+					Genode::log("convert line ", line);
+
+				Char_cell * const drawn   = _drawn_line(line);
+				PT        * const fb_line = _fb_base + line*cell_height*_fb_width;
+
+				for (unsigned column = 0; column < _visible_cols; column++) {
+
+					Char_cell const cell = _cell_array.get_cell(column, line);
+
+					if (same_look(cell, drawn[column]))
+						continue;
+
+					drawn[column] = cell;
+
+					unsigned char const ascii = cell.ascii ? cell.ascii : ' ';
+
+					Color fg_color = foreground_color(cell);
+					Color bg_color = background_color(cell);
+
+					if (cell.has_cursor()) {
+						fg_color = Color( 63,  63,  63);
+						bg_color = Color(255, 255, 255);
+					}
+
+					/* copy pre-rendered glyph into the framebuffer */
+					PT const *src = _glyph_cache.glyph(ascii, fg_color, bg_color);
+					PT       *dst = fb_line + column*cell_width;
+
+					for (unsigned y = 0; y < cell_height; y++) {
+						Genode::memcpy(dst, src, cell_width*sizeof(PT));
+						src += cell_width;
+						dst += _fb_width;
+					}
+
+					first_col  = Genode::min(first_col,  (int)column);
+					last_col   = Genode::max(last_col,   (int)column);
+					first_line = Genode::min(first_line, (int)line);
+					last_line  = Genode::max(last_line,  (int)line);
+				}
+			}
+
+			if (last_col < first_col || last_line < first_line)
+				return Rect();
+
+			return Rect(Point(first_col*cell_width, first_line*cell_height),
+			            Point((last_col + 1)*cell_width - 1,
+			                  (last_line + 1)*cell_height - 1));
+		}
+};
+
+
 namespace Terminal {
 
 	struct Flush_callback : Genode::List<Flush_callback>::Element
@@ -306,6 +548,8 @@ namespace Terminal {
 
 			Font_family const               &_font_family;
 
+			Pixel_screen<Pixel_rgb565>       _pixel_screen;
+
 			/**
 			 * Initialize framebuffer-related attributes
 			 */
@@ -353,7 +597,10 @@ namespace Terminal {
 				_char_cell_array_character_screen(_char_cell_array),
 				_decoder(_char_cell_array_character_screen),
 
-				_font_family(font_family)
+				_font_family(font_family),
+				_pixel_screen(alloc, _char_cell_array, font_family,
+				              (Pixel_rgb565 *)_fb_addr,
+				              _fb_mode.width(), _fb_mode.height())
 			{
 				using namespace Genode;
 
@@ -376,30 +623,10 @@ namespace Terminal {
 			{
 				Genode::Lock::Guard guard(_lock);
 
-				convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
-				                                           (Pixel_rgb565 *)_fb_addr,
-				                                           _fb_mode.width(),
-				                                           _fb_mode.height(),
-				                                           _font_family);
-
-				
-				int first_dirty_line =  10000,
-				    last_dirty_line  = -10000;
-
-				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
-					if (!_char_cell_array.line_dirty(line)) continue;
-
-					first_dirty_line = Genode::min(line, first_dirty_line);
-					last_dirty_line  = Genode::max(line, last_dirty_line);
-
-					_char_cell_array.mark_line_as_clean(line);
-				}
+				Genode::Surface_base::Rect const dirty = _pixel_screen.convert();
 
-				int num_dirty_lines = last_dirty_line - first_dirty_line + 1;
-				if (num_dirty_lines > 0)
-					_framebuffer.refresh(0, first_dirty_line*_char_height,
-					                     _fb_mode.width(),
-					                     num_dirty_lines*_char_height);
+				if (dirty.valid())
+					_framebuffer.refresh(dirty.x1(), dirty.y1(), dirty.w(), dirty.h());
 			}
 
 
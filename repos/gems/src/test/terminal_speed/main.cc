@@ -0,0 +1,90 @@
+/*
+ * \brief  Benchmark for the sustained output rate of a terminal
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <terminal_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Terminal::Connection _terminal { _env };
+
+	enum { DURATION_MS = 10*1000, REPORT_MS = 1000, LINE_LEN = 80 };
+
+	char _line[LINE_LEN + 2];
+
+	/**
+	 * Fill line with a varying pattern resembling build-log output
+	 */
+	size_t _generate_line(unsigned long n)
+	{
+		unsigned const len = 20 + n % (LINE_LEN - 20);
+
+		for (unsigned i = 0; i < len; i++)
+			_line[i] = 'a' + (n + i) % 26;
+
+		_line[len]     = '\r';
+		_line[len + 1] = '\n';
+
+		return len + 2;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- terminal output benchmark started ---");
+
+		unsigned long const start_ms  = _timer.elapsed_ms();
+		unsigned long       report_ms = start_ms;
+		unsigned long       lines     = 0;
+		unsigned long       reported  = 0;
+
+		for (;;) {
+
+			_terminal.write(_line, _generate_line(lines));
+			lines++;
+
+			unsigned long const now_ms = _timer.elapsed_ms();
+
+			if (now_ms - report_ms < REPORT_MS)
+				continue;
+
+			log("lines/s: ", (lines - reported)*1000/(now_ms - report_ms));
+
+			reported  = lines;
+			report_ms = now_ms;
+
+			if (now_ms - start_ms >= DURATION_MS)
+				break;
+		}
+
+		log("sustained lines/s: ",
+		    lines*1000/(_timer.elapsed_ms() - start_ms));
+
+		log("--- finished terminal output benchmark ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-terminal_speed
+SRC_CC = main.cc
+LIBS   = base
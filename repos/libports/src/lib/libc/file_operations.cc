@@ -443,7 +443,8 @@ extern "C" void *mmap(void *addr, ::size_t length, int prot, int flags,
 	}
 
 	void *start = fd->plugin->mmap(addr, length, prot, flags, fd, offset);
-	mmap_registry()->insert(start, length, fd->plugin);
+	if (start != MAP_FAILED)
+		mmap_registry()->insert(start, length, fd->plugin);
 	return start;
 }
 
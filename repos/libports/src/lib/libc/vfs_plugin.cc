@@ -16,6 +16,7 @@
 /* Genode includes */
 #include <base/env.h>
 #include <base/log.h>
+#include <dataspace/client.h>
 #include <vfs/dir_file_system.h>
 
 /* libc includes */
@@ -409,16 +410,35 @@ ssize_t Libc::Vfs_plugin::write(Libc::File_descriptor *fd, const void *buf,
 			  out_result(out_result)
 			{ }
 
+			/*
+			 * A file system may accept only a part of the data at once,
+			 * e.g., the portion that fits into its packet buffer. Hence,
+			 * the remaining data is written successively.
+			 */
 			bool suspend() override
 			{
-				try {
-					out_result = handle->fs().write(handle, (char const *)buf,
-						                            count, out_count);
-					retry = false;
-				} catch (Vfs::File_io_service::Insufficient_buffer) {
-					retry = true;
+				while (out_count < count) {
+
+					Vfs::file_size partial_count = 0;
+
+					try {
+						out_result = handle->fs().write(handle,
+						                                (char const *)buf + out_count,
+						                                count - out_count,
+						                                partial_count);
+					} catch (Vfs::File_io_service::Insufficient_buffer) {
+						retry = true;
+						return retry;
+					}
+
+					if (out_result != Result::WRITE_OK || partial_count == 0)
+						break;
+
+					handle->advance_seek(partial_count);
+					out_count += partial_count;
 				}
 
+				retry = false;
 				return retry;
 			}
 		} check(handle, buf, count, out_count, out_result);
@@ -426,6 +446,10 @@ ssize_t Libc::Vfs_plugin::write(Libc::File_descriptor *fd, const void *buf,
 		do {
 			Libc::suspend(check);
 		} while (check.retry);
+
+		/* the seek offset was advanced for each portion already */
+		if (out_count)
+			return out_count;
 	}
 
 	switch (out_result) {
@@ -1110,46 +1134,174 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
+void *Libc::Vfs_plugin::_mmap_dataspace(::size_t length, int prot,
+                                        Libc::File_descriptor *fd, ::off_t offset)
+{
+	/*
+	 * File systems like the RAM or TAR file system create the dataspace by
+	 * copying the whole file. To not pay this cost for a mapping of a small
+	 * part of a large file, the dataspace is used only if the mapping
+	 * covers the whole file.
+	 */
+	struct stat st;
+	if (offset != 0 || ::fstat(fd->libc_fd, &st) == -1
+	 || length < (::size_t)st.st_size)
+		return MAP_FAILED;
+
+	Genode::Dataspace_capability ds = _root_dir.dataspace(fd->fd_path);
+	if (!ds.valid())
+		return MAP_FAILED;
+
+	/* fall back to copying if the mapping exceeds the dataspace */
+	if ((Genode::size_t)offset + length > Genode::Dataspace_client(ds).size()) {
+		_root_dir.release(fd->fd_path, ds);
+		return MAP_FAILED;
+	}
+
+	bool const executable = prot & PROT_EXEC;
+
+	void *addr = nullptr;
+	try {
+		addr = _rm.attach(ds, length, offset, false, (void *)0,
+		                        executable, false);
+	} catch (...) {
+		_root_dir.release(fd->fd_path, ds);
+		return MAP_FAILED;
+	}
+
+	Mapping *mapping = new (_alloc)
+		Mapping(addr, length, executable, ds, fd->fd_path);
+
+	Genode::Lock::Guard guard(_mappings_lock);
+	_mappings.insert(mapping);
+	return addr;
+}
+
+
+void *Libc::Vfs_plugin::_mmap_copy(::size_t length, int prot,
+                                   Libc::File_descriptor *fd, ::off_t offset)
+{
+	bool const executable = prot & PROT_EXEC;
+
+	void *addr = Libc::mem_alloc(executable)->alloc(length, PAGE_SHIFT);
+	if (!addr) {
+		errno = ENOMEM;
+		return MAP_FAILED;
+	}
+
+	/*
+	 * Read the mapped file range, which may be delivered by several partial
+	 * reads. The part of the mapping beyond the end of the file reads as
+	 * zero.
+	 */
+	::size_t count = 0;
+	while (count < length) {
+		ssize_t const n = ::pread(fd->libc_fd, (char *)addr + count,
+		                          length - count, offset + count);
+		if (n == 0)
+			break;
+
+		if (n < 0) {
+			Genode::error("mmap could not obtain file content");
+			Libc::mem_alloc(executable)->free(addr);
+			errno = EACCES;
+			return MAP_FAILED;
+		}
+		count += n;
+	}
+	Genode::memset((char *)addr + count, 0, length - count);
+
+	Mapping *mapping = new (_alloc)
+		Mapping(addr, length, executable,
+		        Genode::Dataspace_capability(), fd->fd_path);
+
+	Genode::Lock::Guard guard(_mappings_lock);
+	_mappings.insert(mapping);
+	return addr;
+}
+
+
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              Libc::File_descriptor *fd, ::off_t offset)
 {
-	if (prot != PROT_READ) {
-		Genode::error("mmap for prot=", Genode::Hex(prot), " not supported");
-		errno = EACCES;
-		return (void *)-1;
+	/* a non-fixed 'addr_in' is merely a hint, which we do not follow */
+	if (flags & MAP_FIXED) {
+		Genode::error("mmap for predefined address not supported");
+		errno = EINVAL;
+		return MAP_FAILED;
 	}
 
-	if (addr_in != 0) {
-		Genode::error("mmap for predefined address not supported");
+	if (!length || (offset & ((1UL << PAGE_SHIFT) - 1))) {
 		errno = EINVAL;
-		return (void *)-1;
+		return MAP_FAILED;
 	}
 
 	/*
-	 * XXX attempt to obtain memory mapping via
-	 *     'Vfs::Directory_service::dataspace'.
+	 * Shared writeable mappings are not supported. A copy of the file
+	 * content is neither coherent with other mappings nor with writes to
+	 * the file, and writing it back would overwrite such concurrent
+	 * modifications.
 	 */
-
-	void *addr = Libc::mem_alloc()->alloc(length, PAGE_SHIFT);
-	if (addr == (void *)-1) {
-		errno = ENOMEM;
-		return (void *)-1;
+	if ((flags & MAP_SHARED) && (prot & PROT_WRITE)) {
+		Genode::error("mmap for shared writeable mapping not supported");
+		errno = EACCES;
+		return MAP_FAILED;
 	}
 
-	if (::pread(fd->libc_fd, addr, length, offset) < 0) {
-		Genode::error("mmap could not obtain file content");
-		::munmap(addr, length);
+	if ((fd->flags & O_ACCMODE) == O_WRONLY) {
 		errno = EACCES;
-		return (void *)-1;
+		return MAP_FAILED;
 	}
 
-	return addr;
+	/*
+	 * A mapping that is never written can refer to the dataspace of the file
+	 * system directly, which spares the copy of the file content, e.g., for
+	 * ROM modules.
+	 */
+	if (!(prot & PROT_WRITE)) {
+		void *addr = _mmap_dataspace(length, prot, fd, offset);
+		if (addr != MAP_FAILED)
+			return addr;
+	}
+
+	return _mmap_copy(length, prot, fd, offset);
 }
 
 
 int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 {
-	Libc::mem_alloc()->free(addr);
+	Mapping *mapping = nullptr;
+	{
+		Genode::Lock::Guard guard(_mappings_lock);
+
+		mapping = _lookup_mapping(addr);
+		if (mapping)
+			_mappings.remove(mapping);
+	}
+
+	if (!mapping)
+		return Errno(EINVAL);
+
+	if (mapping->ds.valid()) {
+		_rm.detach(mapping->start);
+		_root_dir.release(mapping->path.string(), mapping->ds);
+	} else {
+		Libc::mem_alloc(mapping->executable)->free(mapping->start);
+	}
+
+	destroy(_alloc, mapping);
+	return 0;
+}
+
+
+int Libc::Vfs_plugin::msync(void *addr, ::size_t, int)
+{
+	/* mappings are never shared writeable, so there is nothing to write back */
+	Genode::Lock::Guard guard(_mappings_lock);
+
+	if (!_lookup_mapping(addr))
+		return Errno(ENOMEM);
+
 	return 0;
 }
 
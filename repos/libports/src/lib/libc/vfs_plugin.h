@@ -18,6 +18,9 @@
 
 /* Genode includes */
 #include <libc/component.h>
+#include <base/lock.h>
+#include <util/list.h>
+#include <dataspace/capability.h>
 #include "task.h"
 
 /* libc includes */
@@ -35,10 +38,61 @@ class Libc::Vfs_plugin : public Libc::Plugin
 {
 	private:
 
+		Genode::Region_map &_rm;
+
 		Genode::Allocator &_alloc;
 
 		Vfs::File_system &_root_dir;
 
+		/**
+		 * Meta data of a file mapping
+		 *
+		 * A mapping is either backed by a dataspace provided by the file
+		 * system, which is attached read-only, or by libc memory that
+		 * holds a copy of the mapped file range.
+		 */
+		struct Mapping : Genode::List<Mapping>::Element
+		{
+			typedef Genode::String<Vfs::MAX_PATH_LEN> Path;
+
+			void    * const start;
+			::size_t  const length;
+			bool      const executable;
+
+			Genode::Dataspace_capability const ds;
+			Path                         const path;
+
+			Mapping(void *start, ::size_t length, bool executable,
+			        Genode::Dataspace_capability ds, char const *path)
+			:
+				start(start), length(length), executable(executable),
+				ds(ds), path(path)
+			{ }
+
+			bool contains(void const *addr) const
+			{
+				return addr >= start && (char const *)addr < (char const *)start + length;
+			}
+		};
+
+		Genode::Lock          _mappings_lock { };
+		Genode::List<Mapping> _mappings      { };
+
+		/**
+		 * Return mapping that contains 'addr', the caller must hold
+		 * '_mappings_lock'
+		 */
+		Mapping *_lookup_mapping(void const *addr)
+		{
+			for (Mapping *m = _mappings.first(); m; m = m->next())
+				if (m->contains(addr))
+					return m;
+			return nullptr;
+		}
+
+		void *_mmap_dataspace(::size_t, int, Libc::File_descriptor *, ::off_t);
+		void *_mmap_copy(::size_t, int, Libc::File_descriptor *, ::off_t);
+
 		void _open_stdio(Genode::Xml_node const &node, char const *attr,
 		                 int libc_fd, unsigned flags)
 		{
@@ -141,7 +195,7 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs_plugin(Libc::Env &env, Genode::Allocator &alloc)
 		:
-			_alloc(alloc), _root_dir(env.vfs())
+			_rm(env.rm()), _alloc(alloc), _root_dir(env.vfs())
 		{
 			using Genode::Xml_node;
 
@@ -209,6 +263,7 @@ class Libc::Vfs_plugin : public Libc::Plugin
 		ssize_t write(Libc::File_descriptor *, const void *, ::size_t ) override;
 		void   *mmap(void *, ::size_t, int, int, Libc::File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
+		int     msync(void *, ::size_t, int) override;
 		int     select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout) override;
 };
 
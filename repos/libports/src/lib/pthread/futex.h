@@ -0,0 +1,290 @@
+/*
+ * \brief  Wait queue keyed by a memory word, in the style of a Linux futex
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The pthread synchronization primitives keep their state in a single word
+ * that is manipulated by atomic operations. Only if a thread has to block,
+ * it enters the wait queue of the primitive. The queue is protected by a
+ * lock of its own, which is never touched in the uncontended case.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SRC_LIB_PTHREAD_FUTEX_H_
+#define _INCLUDE__SRC_LIB_PTHREAD_FUTEX_H_
+
+/* Genode includes */
+#include <base/lock.h>
+#include <cpu/atomic.h>
+#include <os/timed_semaphore.h>
+
+namespace Pthread {
+
+	class Futex;
+
+	/**
+	 * Atomically replace the value of 'word' and return the previous value
+	 */
+	static inline int atomic_exchange(int volatile *word, int value)
+	{
+		for (;;) {
+			int const old = *word;
+			if (Genode::cmpxchg(word, old, value))
+				return old;
+		}
+	}
+
+	/**
+	 * Atomically increment the value of 'word'
+	 */
+	static inline void atomic_increment(int volatile *word)
+	{
+		for (;;) {
+			int const old = *word;
+			if (Genode::cmpxchg(word, old, old + 1))
+				return;
+		}
+	}
+}
+
+
+class Pthread::Futex : Genode::Noncopyable
+{
+	private:
+
+		struct Waiter
+		{
+			Genode::Timed_semaphore sem { };
+
+			Waiter *next = nullptr;
+
+			/* queue the waiter is enqueued in, updated on requeue */
+			Futex * volatile futex = nullptr;
+
+			bool queued = false;
+		};
+
+		Genode::Lock _lock { };
+
+		Waiter *_head = nullptr;
+		Waiter *_tail = nullptr;
+
+		void _enqueue(Waiter &waiter)
+		{
+			waiter.next   = nullptr;
+			waiter.futex  = this;
+			waiter.queued = true;
+
+			if (_tail) _tail->next = &waiter;
+			else       _head       = &waiter;
+
+			_tail = &waiter;
+		}
+
+		Waiter *_dequeue()
+		{
+			Waiter * const waiter = _head;
+			if (!waiter)
+				return nullptr;
+
+			_head = waiter->next;
+			if (!_head)
+				_tail = nullptr;
+
+			waiter->next   = nullptr;
+			waiter->queued = false;
+			return waiter;
+		}
+
+		void _remove(Waiter &waiter)
+		{
+			Waiter *prev = nullptr;
+			for (Waiter *w = _head; w; prev = w, w = w->next) {
+
+				if (w != &waiter)
+					continue;
+
+				if (prev) prev->next = w->next;
+				else      _head      = w->next;
+
+				if (_tail == w)
+					_tail = prev;
+
+				w->next   = nullptr;
+				w->queued = false;
+				return;
+			}
+		}
+
+		/**
+		 * Remove timed-out waiter from the queue it is currently enqueued in
+		 *
+		 * \return false if the waiter was already dequeued by a wake-up
+		 */
+		static bool _withdraw(Waiter &waiter)
+		{
+			for (;;) {
+				Futex &futex = *waiter.futex;
+
+				Genode::Lock::Guard guard(futex._lock);
+
+				/* waiter got requeued meanwhile */
+				if (waiter.futex != &futex)
+					continue;
+
+				if (!waiter.queued)
+					return false;
+
+				futex._remove(waiter);
+				return true;
+			}
+		}
+
+		/**
+		 * Wake up the waiters of the given list
+		 *
+		 * Must be called without holding the queue lock.
+		 */
+		static void _wake_up(Waiter *list)
+		{
+			while (list) {
+
+				/* the waiter may vanish as soon as it is woken up */
+				Waiter * const next = list->next;
+				list->sem.up();
+				list = next;
+			}
+		}
+
+		/**
+		 * Dequeue up to 'n' waiters into a list
+		 */
+		Waiter *_dequeue_list(unsigned n)
+		{
+			Waiter *list = nullptr, *last = nullptr;
+
+			for (unsigned i = 0; i < n; i++) {
+
+				Waiter * const waiter = _dequeue();
+				if (!waiter)
+					break;
+
+				if (last) last->next = waiter;
+				else      list       = waiter;
+
+				last = waiter;
+			}
+			return list;
+		}
+
+		/**
+		 * Block if 'word' has the 'expected' value
+		 *
+		 * \param timeout_ms  timeout in milliseconds, or nullptr to block
+		 *                    without timeout
+		 *
+		 * \return false on timeout
+		 */
+		bool _wait(int volatile *word, int expected,
+		           Genode::Alarm::Time const *timeout_ms)
+		{
+			Waiter waiter;
+
+			{
+				Genode::Lock::Guard guard(_lock);
+
+				/* the word was changed before we could block */
+				if (*word != expected)
+					return true;
+
+				_enqueue(waiter);
+			}
+
+			if (!timeout_ms) {
+				waiter.sem.down();
+				return true;
+			}
+
+			try {
+				waiter.sem.down(*timeout_ms);
+				return true;
+			}
+			catch (Genode::Timeout_exception)     { }
+			catch (Genode::Nonblocking_exception) { }
+
+			if (_withdraw(waiter))
+				return false;
+
+			/* consume the wake-up that raced with the timeout */
+			waiter.sem.down();
+			return true;
+		}
+
+	public:
+
+		/**
+		 * Block until woken up if 'word' has the 'expected' value
+		 *
+		 * The caller may return spuriously and must re-evaluate the word.
+		 */
+		void wait(int volatile *word, int expected) {
+			_wait(word, expected, nullptr); }
+
+		/**
+		 * Block until woken up or the timeout triggered
+		 *
+		 * \return false on timeout
+		 */
+		bool wait(int volatile *word, int expected, Genode::Alarm::Time timeout_ms) {
+			return _wait(word, expected, &timeout_ms); }
+
+		/**
+		 * Wake up to 'n' waiters
+		 */
+		void wake(unsigned n)
+		{
+			Waiter *list = nullptr;
+			{
+				Genode::Lock::Guard guard(_lock);
+				list = _dequeue_list(n);
+			}
+			_wake_up(list);
+		}
+
+		/**
+		 * Wake up one waiter and move all others to the queue of 'to'
+		 *
+		 * Instead of waking up all waiters of a condition variable only to
+		 * let them contend for the associated mutex, the waiters are moved
+		 * to the queue of the mutex. They are woken up one after another by
+		 * the subsequent mutex releases.
+		 *
+		 * The lock of this queue is acquired before the lock of 'to'. Hence,
+		 * requeuing is supported in one direction only, i.e., from
+		 * condition variables to mutexes.
+		 */
+		void requeue(Futex &to)
+		{
+			Waiter *list = nullptr;
+			{
+				Genode::Lock::Guard guard(_lock);
+				list = _dequeue_list(1);
+
+				if (_head) {
+					Genode::Lock::Guard to_guard(to._lock);
+
+					while (Waiter * const waiter = _dequeue())
+						to._enqueue(*waiter);
+				}
+			}
+			_wake_up(list);
+		}
+};
+
+#endif /* _INCLUDE__SRC_LIB_PTHREAD_FUTEX_H_ */
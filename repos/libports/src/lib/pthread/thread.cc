@@ -21,6 +21,7 @@
 #include <pthread.h>
 #include <stdlib.h> /* malloc, free */
 #include "thread.h"
+#include "futex.h"
 
 using namespace Genode;
 
@@ -273,155 +274,145 @@ extern "C" {
 	};
 
 
+	/*
+	 * The mutex state is kept in a single word that is acquired and released
+	 * via atomic operations. The futex is entered only if the mutex is
+	 * contended, following "Futexes Are Tricky" by Ulrich Drepper.
+	 */
 	struct pthread_mutex
 	{
+		enum State { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
+
+		/*
+		 * Number of attempts to acquire a locked mutex before blocking,
+		 * which pays off if the mutex is held for short periods only
+		 */
+		enum { SPIN_LIMIT = 100 };
+
 		pthread_mutex_attr mutexattr;
 
-		Lock mutex_lock;
+		int volatile   state = UNLOCKED;
+		Pthread::Futex futex { };
 
-		pthread_t owner;
-		int       lock_count;
-		Lock      owner_and_counter_lock;
+		/* used by recursive and error-checking mutexes only */
+		pthread_t owner      = 0;
+		int       lock_count = 0;
 
 		pthread_mutex(const pthread_mutexattr_t *__restrict attr)
-		: owner(0),
-		  lock_count(0)
 		{
 			if (attr && *attr)
 				mutexattr = **attr;
 		}
 
-		int lock()
+		bool _normal() const
 		{
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
-
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
-					lock_count++;
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					mutex_lock.lock();
-					return 0;
-				}
-			}
+			return mutexattr.type != PTHREAD_MUTEX_RECURSIVE
+			    && mutexattr.type != PTHREAD_MUTEX_ERRORCHECK;
+		}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+		/**
+		 * Acquire mutex
+		 *
+		 * \param locked_state  state set on the uncontended acquisition,
+		 *                      'CONTENDED' if further threads may wait in
+		 *                      the futex
+		 */
+		void _acquire(int locked_state)
+		{
+			if (cmpxchg(&state, UNLOCKED, locked_state))
+				return;
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			for (unsigned i = 0; i < SPIN_LIMIT; i++)
+				if (state == UNLOCKED && cmpxchg(&state, UNLOCKED, locked_state))
+					return;
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
+			while (Pthread::atomic_exchange(&state, CONTENDED) != UNLOCKED)
+				futex.wait(&state, CONTENDED);
+		}
 
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					mutex_lock.lock();
-					return 0;
-				} else
-					return EDEADLK;
-			}
+		void _release()
+		{
+			if (cmpxchg(&state, LOCKED, UNLOCKED))
+				return;
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.lock();
-			return 0;
+			state = UNLOCKED;
+			futex.wake(1);
 		}
 
-		int trylock()
+		int _lock(int locked_state)
 		{
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
-
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
-					lock_count++;
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					return EBUSY;
-				}
+			if (_normal()) {
+				_acquire(locked_state);
+				return 0;
 			}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
-
-				Lock::Guard lock_guard(owner_and_counter_lock);
+			pthread_t const myself = pthread_self();
 
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					return EBUSY;
-				} else
+			/* the mutex is already locked by the caller */
+			if (owner == myself) {
+				if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK)
 					return EDEADLK;
-			}
-
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			Lock::Guard lock_guard(owner_and_counter_lock);
 
-			if (lock_count == 0) {
-				owner = pthread_self();
-				mutex_lock.lock();
+				lock_count++;
 				return 0;
 			}
 
-			return EBUSY;
+			_acquire(locked_state);
+			owner      = myself;
+			lock_count = 1;
+			return 0;
 		}
 
-		int unlock()
-		{
-
-			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
+		int lock() { return _lock(LOCKED); }
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
+		/**
+		 * Acquire mutex after having been woken up from a condition variable
+		 *
+		 * The waiters of a condition variable may have been requeued to the
+		 * futex of the mutex. Hence, the mutex must be marked as contended
+		 * to let the next release wake up one of them.
+		 */
+		int lock_contended() { return _lock(CONTENDED); }
 
-				if (pthread_self() != owner)
-					return EPERM;
+		int trylock()
+		{
+			if (_normal())
+				return cmpxchg(&state, UNLOCKED, LOCKED) ? 0 : EBUSY;
 
-				lock_count--;
+			pthread_t const myself = pthread_self();
 
-				if (lock_count == 0) {
-					owner = 0;
-					mutex_lock.unlock();
-				}
+			/* the mutex is already locked by the caller */
+			if (owner == myself) {
+				if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK)
+					return EDEADLK;
 
+				lock_count++;
 				return 0;
 			}
 
-			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
+			if (!cmpxchg(&state, UNLOCKED, LOCKED))
+				return EBUSY;
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (pthread_self() != owner)
-					return EPERM;
+			owner      = myself;
+			lock_count = 1;
+			return 0;
+		}
 
-				owner = 0;
-				mutex_lock.unlock();
+		int unlock()
+		{
+			if (_normal()) {
+				_release();
 				return 0;
 			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.unlock();
+			if (pthread_self() != owner)
+				return EPERM;
+
+			if (--lock_count > 0)
+				return 0;
+
+			owner = 0;
+			_release();
 			return 0;
 		}
 	};
@@ -493,9 +484,7 @@ extern "C" {
 		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
 			pthread_mutex_init(mutex, 0);
 
-		(*mutex)->lock();
-
-		return 0;
+		return (*mutex)->lock();
 	}
 
 
@@ -519,9 +508,7 @@ extern "C" {
 		if (*mutex == PTHREAD_MUTEX_INITIALIZER)
 			pthread_mutex_init(mutex, 0);
 
-		(*mutex)->unlock();
-
-		return 0;
+		return (*mutex)->unlock();
 	}
 
 
@@ -529,19 +516,18 @@ extern "C" {
 
 
 	/*
-	 * Implementation based on
-	 * http://web.archive.org/web/20010914175514/http://www-classic.be.com/aboutbe/benewsletter/volume_III/Issue40.html#Workshop
+	 * Waiters block in the futex as long as the sequence number is unchanged.
+	 * Each signal increments the sequence number, which prevents lost
+	 * wake-ups between the release of the mutex and the blocking of the
+	 * waiter.
 	 */
-
 	struct pthread_cond
 	{
-		int num_waiters;
-		int num_signallers;
-		Lock counter_lock;
-		Timed_semaphore signal_sem;
-		Semaphore handshake_sem;
+		int volatile   seq = 0;
+		Pthread::Futex futex { };
 
-		pthread_cond() : num_waiters(0), num_signallers(0) { }
+		/* mutex used by the most recent waiter, target of broadcast requeuing */
+		pthread_mutex * volatile mutex = nullptr;
 	};
 
 
@@ -650,46 +636,33 @@ extern "C" {
 	{
 		int result = 0;
 
-		if (!cond || !*cond)
+		if (!cond || !*cond || !mutex || !*mutex)
 			return EINVAL;
 
-		pthread_cond *c = *cond;
+		pthread_cond  *c = *cond;
+		pthread_mutex *m = *mutex;
+
+		c->mutex = m;
 
-		c->counter_lock.lock();
-		c->num_waiters++;
-		c->counter_lock.unlock();
+		int const seq = c->seq;
 
-		pthread_mutex_unlock(mutex);
+		result = m->unlock();
+		if (result)
+			return result;
 
 		if (!abstime)
-			c->signal_sem.down();
+			c->futex.wait(&c->seq, seq);
 		else {
 			struct timespec currtime;
 			clock_gettime(CLOCK_REALTIME, &currtime);
 
 			Alarm::Time timeout = timeout_ms(currtime, *abstime);
 
-			try {
-				c->signal_sem.down(timeout);
-			} catch (Timeout_exception) {
+			if (!c->futex.wait(&c->seq, seq, timeout))
 				result = ETIMEDOUT;
-			} catch (Genode::Nonblocking_exception) {
-				errno  = ETIMEDOUT;
-				result = ETIMEDOUT;
-			}
-		}
-
-		c->counter_lock.lock();
-		if (c->num_signallers > 0) {
-			if (result == ETIMEDOUT) /* timeout occured */
-				c->signal_sem.down();
-			c->handshake_sem.up();
-			--c->num_signallers;
 		}
-		c->num_waiters--;
-		c->counter_lock.unlock();
 
-		pthread_mutex_lock(mutex);
+		m->lock_contended();
 
 		return result;
 	}
@@ -709,16 +682,10 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-		  ++c->num_signallers;
-		  c->signal_sem.up();
-		  c->counter_lock.unlock();
-		  c->handshake_sem.down();
-		} else
-		  c->counter_lock.unlock();
+		Pthread::atomic_increment(&c->seq);
+		c->futex.wake(1);
 
-	   return 0;
+		return 0;
 	}
 
 
@@ -729,17 +696,16 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-			int still_waiting = c->num_waiters - c->num_signallers;
-			c->num_signallers = c->num_waiters;
-			for (int i = 0; i < still_waiting; i++)
-				c->signal_sem.up();
-			c->counter_lock.unlock();
-			for (int i = 0; i < still_waiting; i++)
-				c->handshake_sem.down();
-		} else
-			c->counter_lock.unlock();
+		Pthread::atomic_increment(&c->seq);
+
+		/*
+		 * Wake up one waiter and let the others wait for the mutex instead
+		 * of waking them all up at once only to contend for the mutex.
+		 */
+		if (pthread_mutex *m = c->mutex)
+			c->futex.requeue(m->futex);
+		else
+			c->futex.wake(~0U);
 
 		return 0;
 	}
@@ -747,35 +713,64 @@ extern "C" {
 	/* TLS */
 
 
+	/*
+	 * The generation of each key is incremented on creation and deletion.
+	 * Hence, an odd generation marks a key as used. The values are stored
+	 * at the calling pthread along with the generation of the key at the
+	 * time of 'pthread_setspecific'. So, values of a deleted key become
+	 * invisible without the need to visit all threads.
+	 */
+	static int volatile key_generation[PTHREAD_KEYS_MAX];
+
+	static bool key_valid(int generation) { return generation & 1; }
+
+
+	/*
+	 * Values of threads not created via the pthread library
+	 */
 	struct Key_element : List<Key_element>::Element
 	{
 		const void *thread_base;
 		const void *value;
+		int         generation;
 
-		Key_element(const void *thread_base, const void *value)
+		Key_element(const void *thread_base, const void *value, int generation)
 		: thread_base(thread_base),
-		  value(value) { }
+		  value(value),
+		  generation(generation) { }
 	};
 
 
 	static Lock key_list_lock;
 	List<Key_element> key_list[PTHREAD_KEYS_MAX];
 
+
+	/**
+	 * Return pthread object of the caller, or nullptr for alien threads
+	 */
+	static pthread *pthread_myself()
+	{
+		try { return static_cast<pthread *>(&Thread::Tls::Base::tls()); }
+		catch (Thread::Tls::Base::Undefined) { }
+
+		/* the pthread object of the main thread is created on demand */
+		return _pthread_main_np() ? pthread_self() : nullptr;
+	}
+
+
 	int pthread_key_create(pthread_key_t *key, void (*destructor)(void*))
 	{
 		if (!key)
 			return EINVAL;
 
-		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
-
 		for (int k = 0; k < PTHREAD_KEYS_MAX; k++) {
-			/*
-			 * Find an empty key slot and insert an element for the current
-			 * thread to mark the key slot as used.
-			 */
-			if (!key_list[k].first()) {
-				Key_element *key_element = new Key_element(Thread::myself(), 0);
-				key_list[k].insert(key_element);
+
+			int const generation = key_generation[k];
+
+			if (key_valid(generation))
+				continue;
+
+			if (cmpxchg(&key_generation[k], generation, generation + 1)) {
 				*key = k;
 				return 0;
 			}
@@ -787,7 +782,13 @@ extern "C" {
 
 	int pthread_key_delete(pthread_key_t key)
 	{
-		if (key < 0 || key >= PTHREAD_KEYS_MAX || !key_list[key].first())
+		if (key < 0 || key >= PTHREAD_KEYS_MAX)
+			return EINVAL;
+
+		int const generation = key_generation[key];
+
+		if (!key_valid(generation) ||
+		    !cmpxchg(&key_generation[key], generation, generation + 1))
 			return EINVAL;
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
@@ -806,6 +807,16 @@ extern "C" {
 		if (key < 0 || key >= PTHREAD_KEYS_MAX)
 			return EINVAL;
 
+		int const generation = key_generation[key];
+
+		if (!key_valid(generation))
+			return EINVAL;
+
+		if (pthread *myself = pthread_myself()) {
+			myself->key_slots[key] = { value, generation };
+			return 0;
+		}
+
 		void *myself = Thread::myself();
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
@@ -813,12 +824,13 @@ extern "C" {
 		for (Key_element *key_element = key_list[key].first(); key_element;
 		     key_element = key_element->next())
 			if (key_element->thread_base == myself) {
-				key_element->value = value;
+				key_element->value      = value;
+				key_element->generation = generation;
 				return 0;
 			}
 
 		/* key element does not exist yet - create a new one */
-		Key_element *key_element = new Key_element(Thread::myself(), value);
+		Key_element *key_element = new Key_element(myself, value, generation);
 		key_list[key].insert(key_element);
 		return 0;
 	}
@@ -829,6 +841,13 @@ extern "C" {
 		if (key < 0 || key >= PTHREAD_KEYS_MAX)
 			return nullptr;
 
+		int const generation = key_generation[key];
+
+		if (pthread *myself = pthread_myself()) {
+			pthread::Key_slot const &slot = myself->key_slots[key];
+			return slot.generation == generation ? (void *)slot.value : nullptr;
+		}
+
 		void *myself = Thread::myself();
 
 		Lock_guard<Lock> key_list_lock_guard(key_list_lock);
@@ -836,7 +855,8 @@ extern "C" {
 		for (Key_element *key_element = key_list[key].first(); key_element;
 		     key_element = key_element->next())
 			if (key_element->thread_base == myself)
-				return (void*)(key_element->value);
+				return key_element->generation == generation
+				       ? (void*)(key_element->value) : nullptr;
 
 		return 0;
 	}
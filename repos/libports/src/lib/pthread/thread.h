@@ -155,6 +155,20 @@ struct pthread : Genode::Noncopyable, Genode::Thread::Tls::Base
 
 	public:
 
+		/**
+		 * Thread-specific value of a key
+		 *
+		 * The value is valid only if the generation matches the current
+		 * generation of the key.
+		 */
+		struct Key_slot
+		{
+			void const *value;
+			int         generation;
+		};
+
+		Key_slot key_slots[PTHREAD_KEYS_MAX] { };
+
 		/**
 		 * Constructor for threads created via 'pthread_create'
 		 */
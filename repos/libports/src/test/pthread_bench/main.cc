@@ -0,0 +1,298 @@
+/*
+ * \brief  Micro benchmark of the pthread synchronization primitives
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The benchmark measures the cost of uncontended and contended mutex
+ * operations, the round-trip time of condition-variable ping-pong, the
+ * wake-up of many waiters by 'pthread_cond_broadcast', and the access of
+ * thread-specific data.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <time.h>
+
+
+enum {
+	UNCONTENDED_ROUNDS = 1000000,
+	CONTENDED_ROUNDS   = 100000,
+	PING_PONG_ROUNDS   = 10000,
+	BROADCAST_ROUNDS   = 1000,
+	TLS_ROUNDS         = 1000000,
+	MAX_THREADS        = 8,
+};
+
+
+static unsigned long long now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec*1000 + ts.tv_nsec/(1000*1000);
+}
+
+
+/*
+ * The pthread library lacks 'pthread_join', hence each thread posts a
+ * semaphore when finished.
+ */
+static sem_t finished;
+
+
+static void start_threads(unsigned num_threads, void *(*fn)(void *))
+{
+	for (unsigned i = 0; i < num_threads; i++) {
+		pthread_t thread;
+		pthread_create(&thread, 0, fn, 0);
+	}
+}
+
+
+static void join_threads(unsigned num_threads)
+{
+	for (unsigned i = 0; i < num_threads; i++)
+		sem_wait(&finished);
+}
+
+
+static void report(char const *name, unsigned long rounds,
+                   unsigned long long start_ms)
+{
+	unsigned long long const duration_ms = now_ms() - start_ms;
+
+	printf("%-32s %8lu rounds in %6llu ms\n", name, rounds, duration_ms);
+}
+
+
+/***********
+ ** Mutex **
+ ***********/
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static unsigned long volatile counter;
+
+
+static void bench_uncontended_mutex()
+{
+	unsigned long long const start = now_ms();
+
+	for (unsigned i = 0; i < UNCONTENDED_ROUNDS; i++) {
+		pthread_mutex_lock(&mutex);
+		counter++;
+		pthread_mutex_unlock(&mutex);
+	}
+
+	report("uncontended mutex", UNCONTENDED_ROUNDS, start);
+}
+
+
+static void *contended_mutex_thread(void *)
+{
+	for (unsigned i = 0; i < CONTENDED_ROUNDS; i++) {
+		pthread_mutex_lock(&mutex);
+		counter++;
+		pthread_mutex_unlock(&mutex);
+	}
+
+	sem_post(&finished);
+	return 0;
+}
+
+
+static void bench_contended_mutex(unsigned num_threads)
+{
+	counter = 0;
+
+	unsigned long long const start = now_ms();
+
+	start_threads(num_threads, contended_mutex_thread);
+	join_threads(num_threads);
+
+	char name[64];
+	snprintf(name, sizeof(name), "contended mutex, %u threads", num_threads);
+	report(name, num_threads*CONTENDED_ROUNDS, start);
+
+	if (counter != num_threads*CONTENDED_ROUNDS)
+		printf("error: counter is %lu, expected %u\n",
+		       counter, num_threads*CONTENDED_ROUNDS);
+}
+
+
+/************************
+ ** Condition variable **
+ ************************/
+
+static pthread_cond_t cond;
+
+static unsigned turn;
+
+
+static void *ping_pong_thread(void *)
+{
+	pthread_mutex_lock(&mutex);
+
+	for (unsigned i = 0; i < PING_PONG_ROUNDS; i++) {
+		while (turn != 1)
+			pthread_cond_wait(&cond, &mutex);
+
+		turn = 0;
+		pthread_cond_signal(&cond);
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	sem_post(&finished);
+	return 0;
+}
+
+
+static void bench_ping_pong()
+{
+	turn = 0;
+	pthread_cond_init(&cond, 0);
+	start_threads(1, ping_pong_thread);
+
+	unsigned long long const start = now_ms();
+
+	pthread_mutex_lock(&mutex);
+
+	for (unsigned i = 0; i < PING_PONG_ROUNDS; i++) {
+		turn = 1;
+		pthread_cond_signal(&cond);
+
+		while (turn != 0)
+			pthread_cond_wait(&cond, &mutex);
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	report("condition-variable ping-pong", PING_PONG_ROUNDS, start);
+
+	join_threads(1);
+	pthread_cond_destroy(&cond);
+}
+
+
+static unsigned generation;
+static unsigned num_waiting;
+
+static pthread_cond_t waiting_cond;
+
+
+static void *broadcast_thread(void *)
+{
+	pthread_mutex_lock(&mutex);
+
+	for (unsigned i = 0; i < BROADCAST_ROUNDS; i++) {
+		unsigned const g = generation;
+
+		num_waiting++;
+		pthread_cond_signal(&waiting_cond);
+
+		while (generation == g)
+			pthread_cond_wait(&cond, &mutex);
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	sem_post(&finished);
+	return 0;
+}
+
+
+static void bench_broadcast(unsigned num_threads)
+{
+	generation  = 0;
+	num_waiting = 0;
+	pthread_cond_init(&cond, 0);
+	pthread_cond_init(&waiting_cond, 0);
+
+	start_threads(num_threads, broadcast_thread);
+
+	unsigned long long const start = now_ms();
+
+	pthread_mutex_lock(&mutex);
+
+	for (unsigned i = 0; i < BROADCAST_ROUNDS; i++) {
+
+		/* wait until all threads are waiting for the broadcast */
+		while (num_waiting != num_threads)
+			pthread_cond_wait(&waiting_cond, &mutex);
+
+		num_waiting = 0;
+		generation++;
+		pthread_cond_broadcast(&cond);
+	}
+
+	pthread_mutex_unlock(&mutex);
+
+	char name[64];
+	snprintf(name, sizeof(name), "broadcast, %u waiters", num_threads);
+	report(name, BROADCAST_ROUNDS, start);
+
+	join_threads(num_threads);
+
+	pthread_cond_destroy(&waiting_cond);
+	pthread_cond_destroy(&cond);
+}
+
+
+/**************************
+ ** Thread-specific data **
+ **************************/
+
+static void bench_tls()
+{
+	pthread_key_t key;
+
+	if (pthread_key_create(&key, 0) != 0) {
+		printf("error: pthread_key_create failed\n");
+		return;
+	}
+
+	unsigned long long const start = now_ms();
+
+	for (unsigned long i = 0; i < TLS_ROUNDS; i++) {
+		pthread_setspecific(key, (void *)i);
+		if (pthread_getspecific(key) != (void *)i) {
+			printf("error: pthread_getspecific returned unexpected value\n");
+			break;
+		}
+	}
+
+	report("setspecific/getspecific", TLS_ROUNDS, start);
+
+	pthread_key_delete(key);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- pthread benchmark ---\n");
+
+	sem_init(&finished, 0, 0);
+
+	bench_uncontended_mutex();
+
+	for (unsigned n = 2; n <= MAX_THREADS; n *= 2)
+		bench_contended_mutex(n);
+
+	bench_ping_pong();
+
+	for (unsigned n = 2; n <= MAX_THREADS; n *= 2)
+		bench_broadcast(n);
+
+	bench_tls();
+
+	printf("--- pthread benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,5 @@
+TARGET   = test-pthread_bench
+SRC_CC   = main.cc
+LIBS     = posix pthread
+
+CC_CXX_WARN_STRICT =
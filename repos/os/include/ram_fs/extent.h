@@ -0,0 +1,295 @@
+/*
+ * \brief  Extent-based data structure for storing sparse files in RAM
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RAM_FS__EXTENT_H_
+#define _INCLUDE__RAM_FS__EXTENT_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <util/avl_tree.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+#include <base/allocator.h>
+#include <file_system_session/file_system_session.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	class Extent_store;
+}
+
+
+/**
+ * Sparse file content stored as extents of variable size
+ *
+ * Each extent covers a contiguous range of the file and is backed by a
+ * single allocation. The extents are kept in an AVL tree ordered by their
+ * offsets. For sequential writers, the capacity of each new extent doubles
+ * up to 'MAX_EXTENT_SIZE', so a large file consists of few large extents.
+ * Ranges that are not covered by written data read as zero.
+ *
+ * In contrast to the 'Chunk_index' hierarchy, the store has no size limit
+ * and releases the content of truncated or punched ranges at the cost of
+ * one operation per affected extent rather than per 4-KiB chunk.
+ */
+class File_system::Extent_store : Noncopyable
+{
+	public:
+
+		enum { MIN_EXTENT_SIZE = 4096,
+		       MAX_EXTENT_SIZE = 1024*1024 };
+
+	private:
+
+		struct Extent : Avl_node<Extent>
+		{
+			file_size_t const offset;
+			size_t      const capacity;
+
+			/*
+			 * Number of bytes up to the last written position, the
+			 * remaining capacity is undefined and reads as zero
+			 */
+			size_t used = 0;
+
+			Extent(file_size_t offset, size_t capacity)
+			: offset(offset), capacity(capacity) { }
+
+			char       *data()       { return (char *)(this + 1); }
+			char const *data() const { return (char const *)(this + 1); }
+
+			file_size_t end() const { return offset + capacity; }
+
+			bool higher(Extent *e) { return e->offset >= offset; }
+		};
+
+		Allocator &_alloc;
+
+		Avl_tree<Extent> _extents { };
+
+		/**
+		 * Return extent with the highest offset below or equal to 'offset'
+		 */
+		Extent *_floor(file_size_t offset) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = _extents.first(); e; ) {
+				if (e->offset <= offset) {
+					result = e;
+					e = e->child(Extent::RIGHT);
+				} else {
+					e = e->child(Extent::LEFT);
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * Return extent with the lowest offset above 'offset'
+		 */
+		Extent *_next(file_size_t offset) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = _extents.first(); e; ) {
+				if (e->offset > offset) {
+					result = e;
+					e = e->child(Extent::LEFT);
+				} else {
+					e = e->child(Extent::RIGHT);
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * Allocate extent at 'offset' for writing 'len' bytes
+		 *
+		 * \param prev  extent preceding 'offset', or nullptr
+		 *
+		 * \throw Out_of_ram
+		 */
+		Extent &_create(file_size_t offset, size_t len, Extent const *prev)
+		{
+			/* grow extents geometrically for sequential writers */
+			size_t size = (prev && prev->end() == offset)
+			            ? min((size_t)MAX_EXTENT_SIZE, 2*prev->capacity)
+			            : (size_t)MIN_EXTENT_SIZE;
+
+			size = min((size_t)MAX_EXTENT_SIZE,
+			           max(size, align_addr(len, 12)));
+
+			/* the new extent must not overlap its successor */
+			if (Extent const *next = _next(offset))
+				size = (size_t)min((file_size_t)size, next->offset - offset);
+
+			/* resort to smaller extents if the allocation fails */
+			for (;;) {
+				void *ptr = nullptr;
+				bool ok = false;
+				try { ok = _alloc.alloc(sizeof(Extent) + size, &ptr); }
+				catch (Out_of_ram) { }
+
+				if (ok) {
+					Extent &extent = *construct_at<Extent>(ptr, offset, size);
+					_extents.insert(&extent);
+					return extent;
+				}
+
+				if (size <= MIN_EXTENT_SIZE)
+					throw Out_of_ram();
+
+				size = max(size/2, (size_t)MIN_EXTENT_SIZE);
+			}
+		}
+
+		void _destroy(Extent &extent)
+		{
+			_extents.remove(&extent);
+
+			size_t const size = sizeof(Extent) + extent.capacity;
+			extent.~Extent();
+			_alloc.free(&extent, size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the extents
+		 */
+		Extent_store(Allocator &alloc) : _alloc(alloc) { }
+
+		~Extent_store()
+		{
+			while (Extent *e = _extents.first())
+				_destroy(*e);
+		}
+
+		/**
+		 * Return position after the highest offset written to
+		 */
+		file_size_t used_size() const
+		{
+			Extent const *last = _floor(~(file_size_t)0);
+			return last ? last->offset + last->used : 0;
+		}
+
+		/**
+		 * Write data to the store
+		 *
+		 * \throw Out_of_ram  data was written partially at most
+		 */
+		void write(char const *src, size_t len, file_size_t offset)
+		{
+			while (len > 0) {
+
+				Extent *extent = _floor(offset);
+				if (!extent || offset >= extent->end())
+					extent = &_create(offset, len, extent);
+
+				size_t const local = (size_t)(offset - extent->offset);
+				size_t const n     = min(len, extent->capacity - local);
+
+				/* zero the gap between the written data and 'offset' */
+				if (local > extent->used)
+					memset(extent->data() + extent->used, 0, local - extent->used);
+
+				memcpy(extent->data() + local, src, n);
+				extent->used = max(extent->used, local + n);
+
+				src    += n;
+				len    -= n;
+				offset += n;
+			}
+		}
+
+		/**
+		 * Read data from the store, holes are filled with zeros
+		 */
+		void read(char *dst, size_t len, file_size_t offset) const
+		{
+			while (len > 0) {
+
+				size_t n = len;
+
+				Extent const *extent = _floor(offset);
+				if (extent && offset < extent->offset + extent->used) {
+
+					size_t const local = (size_t)(offset - extent->offset);
+					n = min(len, extent->used - local);
+					memcpy(dst, extent->data() + local, n);
+
+				} else {
+
+					/* hole up to the next extent */
+					if (Extent const *next = _next(offset))
+						n = (size_t)min((file_size_t)len, next->offset - offset);
+					memset(dst, 0, n);
+				}
+
+				dst    += n;
+				len    -= n;
+				offset += n;
+			}
+		}
+
+		/**
+		 * Turn range into a hole
+		 *
+		 * Extents that lie completely within the range are released.
+		 */
+		void punch(file_size_t offset, file_size_t len)
+		{
+			file_size_t const end = offset + len;
+
+			Extent *extent = _floor(offset);
+			if (!extent)
+				extent = _next(offset);
+
+			while (extent && extent->offset < end) {
+
+				Extent *next = _next(extent->offset);
+
+				file_size_t const used_end = extent->offset + extent->used;
+
+				size_t const from = (size_t)(max(offset, extent->offset) - extent->offset);
+				size_t const to   = (size_t)(min(end, used_end) - extent->offset);
+
+				if (from < to) {
+					if (from == 0 && to == extent->used)
+						_destroy(*extent);
+					else if (to == extent->used)
+						extent->used = from;
+					else
+						memset(extent->data() + from, 0, to - from);
+				}
+
+				extent = next;
+			}
+		}
+
+		/**
+		 * Drop content beyond 'size'
+		 */
+		void truncate(file_size_t size)
+		{
+			file_size_t const used = used_size();
+
+			if (size < used)
+				punch(size, used - size);
+		}
+};
+
+#endif /* _INCLUDE__RAM_FS__EXTENT_H_ */
@@ -149,6 +149,21 @@ struct Report::Root : Genode::Root_component<Session_component>
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
 			_env(env), _rom_registry(rom_registry), _verbose(verbose)
 		{ }
+
+		/**
+		 * Constructor
+		 *
+		 * \param ep_pool  entrypoints that serve the sessions
+		 */
+		Root(Genode::Env              &env,
+		     Genode::Entrypoint_pool  &ep_pool,
+		     Genode::Allocator        &md_alloc,
+		     Rom::Registry_for_writer &rom_registry,
+		     bool                     &verbose)
+		:
+			Genode::Root_component<Session_component>(ep_pool, md_alloc),
+			_env(env), _rom_registry(rom_registry), _verbose(verbose)
+		{ }
 };
 
 #endif /* _INCLUDE__REPORT_ROM__REPORT_SERVICE_H_ */
@@ -18,6 +18,9 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/lock.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -26,6 +29,8 @@ namespace Rom {
 	using Genode::Interface;
 
 	class Module;
+	class Snapshot;
+	class View_factory;
 	class Readable_module;
 	class Registry;
 	class Writer;
@@ -57,6 +62,117 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Factory of read-only views of snapshots
+ *
+ * A view is a managed dataspace with the snapshot's RAM dataspace attached
+ * read-only. The RM session is opened on first use. So users of modules
+ * that never hand out snapshots, like the pointer, need no RM session.
+ */
+class Rom::View_factory : Genode::Noncopyable
+{
+	private:
+
+		Genode::Env &_env;
+
+		Constructible<Genode::Rm_connection> _rm_connection { };
+
+		/* modules of different entrypoints share the factory */
+		Genode::Lock _lock { };
+
+	public:
+
+		View_factory(Genode::Env &env) : _env(env) { }
+
+		/**
+		 * Create view of dataspace 'ds'
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Genode::Capability<Genode::Region_map> create(Genode::Dataspace_capability ds,
+		                                              size_t size)
+		{
+			using namespace Genode;
+
+			Lock::Guard guard(_lock);
+
+			if (!_rm_connection.constructed())
+				_rm_connection.construct(_env);
+
+			Capability<Region_map> view;
+			for (;;) {
+				try { view = _rm_connection->create(size); break; }
+				catch (Out_of_ram)  { _rm_connection->upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm_connection->upgrade_caps(2); }
+			}
+
+			try {
+				for (;;) {
+					try {
+						Region_map_client(view).attach(ds, 0, 0, true, (addr_t)0,
+						                               false, false);
+						return view;
+					}
+					catch (Out_of_ram)  { _rm_connection->upgrade_ram(8*1024); }
+					catch (Out_of_caps) { _rm_connection->upgrade_caps(2); }
+				}
+			}
+			catch (...) {
+				_rm_connection->destroy(view);
+				throw;
+			}
+		}
+
+		/**
+		 * Destroy view, which revokes the access of all its users
+		 */
+		void destroy(Genode::Capability<Genode::Region_map> view)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_rm_connection->destroy(view);
+		}
+};
+
+
+/**
+ * Immutable version of the content of a ROM module
+ *
+ * Each report creates a new snapshot. The snapshot is shared by all ROM
+ * clients that obtained it and stays valid until the last of them has
+ * released it. The clients obtain the snapshot through a read-only view,
+ * which is destroyed once the snapshot is no longer referenced. Hence, a
+ * reader cannot access the content of a later report that reuses the
+ * backing store of the snapshot.
+ */
+class Rom::Snapshot : Genode::Noncopyable
+{
+	private:
+
+		friend class Module;
+
+		Attached_ram_dataspace _ds;
+
+		size_t _size = 0;
+
+		/* number of references, protected by the lock of the module */
+		unsigned _refs = 0;
+
+		/* read-only view, created when the snapshot is acquired by a reader */
+		Genode::Capability<Genode::Region_map> _view    { };
+		Genode::Dataspace_capability           _view_ds { };
+
+		Snapshot(Genode::Ram_session &ram, Genode::Region_map &rm, size_t size)
+		: _ds(ram, rm, size) { }
+
+	public:
+
+		Genode::Dataspace_capability cap() const { return _view_ds; }
+
+		size_t size() const { return _size; }
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -67,14 +183,25 @@ struct Rom::Readable_module : Interface
 	/**
 	 * Read content of ROM module
 	 *
-	 * Called by ROM service when a dataspace is obtained by the client.
-	 *
 	 * \throw Buffer_too_small
 	 */
 	virtual size_t read_content(Reader const &reader, char *dst,
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Obtain the current snapshot of the module content
+	 *
+	 * Called by ROM service when a dataspace is obtained by the client.
+	 *
+	 * \return  snapshot, or nullptr if no content is readable by 'reader'
+	 *
+	 * A returned snapshot must be released via 'release_snapshot'.
+	 */
+	virtual Snapshot const *acquire_snapshot(Reader const &reader) const = 0;
+
+	virtual void release_snapshot(Snapshot const &snapshot) const = 0;
 };
 
 
@@ -92,6 +219,9 @@ struct Rom::Readable_module : Interface
  * the server's quota.
  *
  * The Rom::Module gets destroyed when no client refers to it anymore.
+ *
+ * The report and ROM sessions referring to a module may be served by
+ * different entrypoints. Hence, the module state is protected by a lock.
  */
 struct Rom::Module : private Module_list::Element, Readable_module
 {
@@ -136,12 +266,16 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		Name _name;
 
+		Genode::Allocator   &_alloc;
 		Genode::Ram_session &_ram;
 		Genode::Region_map  &_rm;
+		View_factory        &_views;
 
 		Read_policy  const &_read_policy;
 		Write_policy const &_write_policy;
 
+		Genode::Lock mutable _lock { };
+
 		Reader_list mutable _readers { };
 		Writer_list mutable _writers { };
 
@@ -151,18 +285,74 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		Writer const *_last_writer = nullptr;
 
 		/**
-		 * Dataspace used as backing store
+		 * Snapshot of the current content
 		 *
 		 * The buffer for the content is not allocated from the heap to
 		 * allow for the immediate release of the underlying backing store when
 		 * the module gets destructed.
 		 */
-		Constructible<Attached_ram_dataspace> _ds { };
+		Snapshot mutable *_current = nullptr;
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Snapshot no longer referenced by any reader, kept for reuse by
+		 * the next report
 		 */
-		size_t _size = 0;
+		Snapshot mutable *_spare = nullptr;
+
+		/**
+		 * Drop reference to snapshot, called with '_lock' held
+		 */
+		void _release(Snapshot &snapshot) const
+		{
+			if (--snapshot._refs)
+				return;
+
+			if (snapshot._view.valid()) {
+				_views.destroy(snapshot._view);
+				snapshot._view    = Genode::Capability<Genode::Region_map>();
+				snapshot._view_ds = Genode::Dataspace_capability();
+			}
+
+			if (_spare)
+				Genode::destroy(_alloc, _spare);
+
+			_spare = &snapshot;
+		}
+
+		/**
+		 * Return unreferenced snapshot with a capacity of at least 'size'
+		 */
+		Snapshot &_alloc_snapshot(size_t size)
+		{
+			Snapshot *snapshot = nullptr;
+			{
+				Genode::Lock::Guard guard(_lock);
+				snapshot = _spare;
+				_spare = nullptr;
+			}
+
+			if (snapshot && snapshot->_ds.size() >= size)
+				return *snapshot;
+
+			if (snapshot)
+				Genode::destroy(_alloc, snapshot);
+
+			return *new (_alloc) Snapshot(_ram, _rm, size);
+		}
+
+		/**
+		 * Replace current snapshot, called with '_lock' held
+		 */
+		void _replace_current(Snapshot *snapshot)
+		{
+			if (snapshot)
+				snapshot->_refs++;
+
+			if (_current)
+				_release(*_current);
+
+			_current = snapshot;
+		}
 
 
 		/********************************
@@ -174,23 +364,28 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		/**
 		 * Constructor
 		 *
+		 * \param alloc         allocator for the meta data of snapshots
 		 * \param ram           RAM session from which to allocate the module's
 		 *                      backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
+		 * \param views         factory of the read-only views handed out
+		 *                      to ROM clients
 		 * \param name          module name
 		 * \param read_policy   policy hook function that is evaluated each
 		 *                      time when the module content is obtained
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
 		 */
-		Module(Genode::Ram_session &ram,
+		Module(Genode::Allocator   &alloc,
+		       Genode::Ram_session &ram,
 		       Genode::Region_map  &rm,
+		       View_factory        &views,
 		       Name          const &name,
 		       Read_policy   const &read_policy,
 		       Write_policy  const &write_policy)
 		:
-			_name(name), _ram(ram), _rm(rm),
+			_name(name), _alloc(alloc), _ram(ram), _rm(rm), _views(views),
 			_read_policy(read_policy), _write_policy(write_policy)
 		{ }
 
@@ -201,6 +396,8 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		bool _reader_registered(Reader const &reader) const
 		{
+			Genode::Lock::Guard guard(_lock);
+
 			for (Reader const *r = _readers.first(); r; r = r->next())
 				if (r == &reader)
 					return true;
@@ -208,23 +405,33 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			return false;
 		}
 
-		void _register(Reader &reader) { _readers.insert(&reader); }
+		void _register(Reader &reader)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_readers.insert(&reader);
+		}
 
-		void _unregister(Reader &reader) { _readers.remove(&reader); }
+		void _unregister(Reader &reader)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_readers.remove(&reader);
+		}
 
 		void _register(Writer &writer)
 		{
+			Genode::Lock::Guard guard(_lock);
 			_writers.insert(&writer);
 		}
 
 		void _unregister(Writer const &writer)
 		{
+			Genode::Lock::Guard guard(_lock);
+
 			_writers.remove(&writer);
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				_replace_current(nullptr);
 				_last_writer = nullptr;
 			}
 		}
@@ -233,11 +440,14 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		bool _in_use() const
 		{
+			Genode::Lock::Guard guard(_lock);
 			return _readers.first() || _writers.first();
 		}
 
 		unsigned _num_writers() const
 		{
+			Genode::Lock::Guard guard(_lock);
+
 			unsigned cnt = 0;
 			for (Writer const *w = _writers.first(); w; w = w->next())
 				cnt++;
@@ -247,36 +457,52 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 	public:
 
+		~Module()
+		{
+			_replace_current(nullptr);
+
+			if (_spare)
+				Genode::destroy(_alloc, _spare);
+		}
+
 		/**
 		 * Assign new content to the ROM module
 		 *
-		 * Called by report service when a new report comes in.
+		 * Called by report service when a new report comes in. The content
+		 * is written to a fresh snapshot, which replaces the current one.
+		 * ROM clients that still refer to the previous snapshot are not
+		 * affected until they obtain the new one.
 		 */
 		void write_content(Writer const &writer, char const * const src, size_t const src_len)
 		{
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
-
-			_last_writer = &writer;
-
 			/*
-			 * Realloc backing store if needed
-			 *
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			Snapshot &snapshot = _alloc_snapshot(src_len + 1);
 
 			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			char * const dst = snapshot._ds.local_addr<char>();
+			Genode::memcpy(dst, src, src_len);
+
+			/*
+			 * Append zero termination and, if the snapshot is recycled, clear
+			 * the remainder of the former content including its termination.
+			 */
+			size_t const old_end = snapshot._size + 1;
+			Genode::memset(dst + src_len, 0,
+			               old_end > src_len + 1 ? old_end - src_len : 1);
+			snapshot._size = src_len;
+
+			Genode::Lock::Guard guard(_lock);
+
+			_last_writer = &writer;
 
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			_replace_current(&snapshot);
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -293,20 +519,70 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			Genode::Lock::Guard guard(_lock);
+
+			if (!_current || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
 				return 0;
 
-			if (dst_len < _size)
+			size_t const size = _current->size();
+
+			if (dst_len < size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			Genode::memcpy(dst, _current->_ds.local_addr<char>(), size);
+			return size;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		virtual size_t size() const override
+		{
+			Genode::Lock::Guard guard(_lock);
+			return _current ? _current->size() : 0;
 		}
 
-		virtual size_t size() const override { return _size; }
+		/**
+		 * Readable_module interface
+		 */
+		Snapshot const *acquire_snapshot(Reader const &reader) const override
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (!_current || !_last_writer)
+				return nullptr;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			if (!_current->_view.valid()) {
+				try {
+					_current->_view = _views.create(_current->_ds.cap(),
+					                                _current->_ds.size());
+				}
+				catch (...) {
+					Genode::error("could not create view of '", _name, "'");
+					return nullptr;
+				}
+				_current->_view_ds =
+					Genode::Region_map_client(_current->_view).dataspace();
+			}
+
+			_current->_refs++;
+			return _current;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		void release_snapshot(Snapshot const &snapshot) const override
+		{
+			Genode::Lock::Guard guard(_lock);
+			_release(const_cast<Snapshot &>(snapshot));
+		}
 
 		Name name() const { return _name; }
 };
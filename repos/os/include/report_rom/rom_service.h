@@ -35,9 +35,6 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 {
 	private:
 
-		Genode::Ram_session &_ram;
-		Genode::Region_map  &_rm;
-
 		Registry_for_reader &_registry;
 
 		Genode::Session_label const _label;
@@ -51,9 +48,10 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Service_denied(); }
 		}
 
-		Constructible<Genode::Attached_ram_dataspace> _ds { };
-
-		size_t _content_size = 0;
+		/**
+		 * Snapshot of the module content handed out to the client
+		 */
+		Snapshot const *_snapshot = nullptr;
 
 		/**
 		 * Keep state of valid content to notify the client only once when
@@ -69,74 +67,63 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				Genode::Signal_transmitter(_sigh).submit();
 		}
 
-	public:
+		void _replace_snapshot(Snapshot const *snapshot)
+		{
+			if (_snapshot)
+				_module.release_snapshot(*_snapshot);
 
-		Session_component(Genode::Ram_session &ram, Genode::Region_map &rm,
-		                  Registry_for_reader &registry,
-		                  Genode::Session_label const &label)
-		:
-			_ram(ram), _rm(rm),
-			_registry(registry), _label(label), _module(_init_module(label))
-		{ }
+			_snapshot = snapshot;
+			_valid    = _snapshot && _snapshot->size() > 0;
+		}
+
+	public:
 
-		/**
-		 * Constructor
-		 *
-		 * \deprecated
-		 * \noapi
-		 */
 		Session_component(Registry_for_reader &registry,
-		                  Genode::Session_label const &label) __attribute__((deprecated))
+		                  Genode::Session_label const &label)
 		:
-			_ram(*Genode::env_deprecated()->ram_session()),
-			_rm(*Genode::env_deprecated()->rm_session()),
 			_registry(registry), _label(label), _module(_init_module(label))
 		{ }
 
 		~Session_component()
 		{
+			_replace_snapshot(nullptr);
 			_registry.release(*this, _module);
 		}
 
 		Genode::Session_label label() const { return _label; }
 
+		/**
+		 * Return dataspace of the current snapshot of the module
+		 *
+		 * The dataspace is a read-only view shared with all other clients
+		 * of the same version of the module content.
+		 */
 		Genode::Rom_dataspace_capability dataspace() override
 		{
 			using namespace Genode;
 
-				/* replace dataspace by new one */
-				/* XXX we could keep the old dataspace if the size fits */
-				_ds.construct(_ram, _rm, _module.size());
+			_replace_snapshot(_module.acquire_snapshot(*this));
 
-				/* fill dataspace content with report contained in module */
-				_content_size =
-					_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
+			if (!_snapshot)
+				return Rom_dataspace_capability();
 
-				_valid = _content_size > 0;
-
-				/* cast RAM into ROM dataspace capability */
-				Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_ds->cap());
-				return static_cap_cast<Rom_dataspace>(ds_cap);
+			/* cast RAM into ROM dataspace capability */
+			Dataspace_capability ds_cap = _snapshot->cap();
+			return static_cap_cast<Rom_dataspace>(ds_cap);
 		}
 
 		bool update() override
 		{
-			if (!_ds.constructed() || _module.size() > _ds->size())
-				return false;
-
-			size_t const new_content_size =
-				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
-
-			/* clear difference between old and new content */
-			if (new_content_size < _content_size)
-				Genode::memset(_ds->local_addr<char>() + new_content_size, 0,
-				               _content_size - new_content_size);
-
-			_content_size = new_content_size;
+			/*
+			 * Snapshots are immutable, so an update in place is possible only
+			 * if the handed-out snapshot is still the current one.
+			 */
+			Snapshot const * const snapshot = _module.acquire_snapshot(*this);
 
-			_valid = _content_size > 0;
+			if (snapshot)
+				_module.release_snapshot(*snapshot);
 
-			return true;
+			return _snapshot && snapshot == _snapshot;
 		}
 
 		void sigh(Genode::Signal_context_capability sigh) override
@@ -188,7 +175,7 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			using namespace Genode;
 
 			return new (md_alloc())
-				Session_component(_env.ram(), _env.rm(), _registry, label_from_args(args));
+				Session_component(_registry, label_from_args(args));
 		}
 
 	public:
@@ -200,6 +187,20 @@ class Rom::Root : public Genode::Root_component<Session_component>
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
 			_env(env), _registry(registry)
 		{ }
+
+		/**
+		 * Constructor
+		 *
+		 * \param ep_pool  entrypoints that serve the sessions
+		 */
+		Root(Genode::Env             &env,
+		     Genode::Entrypoint_pool &ep_pool,
+		     Genode::Allocator       &md_alloc,
+		     Registry_for_reader     &registry)
+		:
+			Genode::Root_component<Session_component>(ep_pool, md_alloc),
+			_env(env), _registry(registry)
+		{ }
 };
 
 #endif /* _INCLUDE__REPORT_ROM__ROM_SERVICE_H_ */
@@ -36,6 +36,15 @@ class Cell_array
 		CELL             **_array;
 		bool              *_line_dirty;
 
+		/*
+		 * Vertical scrolling accumulated since the last call of
+		 * 'flush_scroll_hint'
+		 */
+		int                _scroll_start = 0;
+		int                _scroll_end   = 0;
+		int                _scroll_lines = 0;
+		bool               _scroll_mixed = false;
+
 		typedef CELL *Char_cell_line;
 
 		void _clear_line(Char_cell_line line)
@@ -68,6 +77,14 @@ class Cell_array
 			_array[up ? end: start] = yanked_line;
 
 			_mark_lines_as_dirty(start, end);
+
+			/* track scroll operations applied to the same region */
+			if (_scroll_lines && (start != _scroll_start || end != _scroll_end))
+				_scroll_mixed = true;
+
+			_scroll_start  = start;
+			_scroll_end    = end;
+			_scroll_lines += up ? 1 : -1;
 		}
 
 	public:
@@ -156,6 +173,29 @@ class Cell_array
 				_line_dirty[pos.y] = true;
 		}
 
+		/**
+		 * Call 'fn' with the vertical scrolling applied since the last call
+		 *
+		 * The functor 'fn' takes the first and last line of the scroll region
+		 * and the number of lines scrolled up (or down if negative) as
+		 * arguments. It is not called if no scrolling took place or if
+		 * different regions were scrolled.
+		 *
+		 * The information is merely a hint for front ends that keep a
+		 * rendered representation of the cell array. It allows them to move
+		 * already rendered content instead of redrawing the region. The lines
+		 * of the scroll region are marked as dirty regardless.
+		 */
+		template <typename FN>
+		void flush_scroll_hint(FN const &fn)
+		{
+			if (_scroll_lines && !_scroll_mixed)
+				fn(_scroll_start, _scroll_end, _scroll_lines);
+
+			_scroll_lines = 0;
+			_scroll_mixed = false;
+		}
+
 		unsigned num_cols()  { return _num_cols; }
 		unsigned num_lines() { return _num_lines; }
 };
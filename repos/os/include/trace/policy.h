@@ -19,6 +19,7 @@ typedef Genode::size_t size_t;
 namespace Genode {
 	struct Msgbuf_base;
 	struct Signal_context;
+	struct Lock_stats;
 }
 
 extern "C" size_t max_event_size ();
@@ -28,3 +29,4 @@ extern "C" size_t rpc_dispatch   (char *dst, char const *rpc_name);
 extern "C" size_t rpc_reply      (char *dst, char const *rpc_name);
 extern "C" size_t signal_submit  (char *dst, unsigned const);
 extern "C" size_t signal_receive (char *dst, Genode::Signal_context const &, unsigned);
+extern "C" size_t lock_contended (char *dst, Genode::Lock_stats const &);
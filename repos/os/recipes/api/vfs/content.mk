@@ -1,6 +1,6 @@
-content: include/vfs include/ram_fs/chunk.h lib/mk/vfs.mk src/lib/vfs LICENSE
+content: include/vfs include/ram_fs/extent.h lib/mk/vfs.mk src/lib/vfs LICENSE
 
-include/vfs include/ram_fs/chunk.h lib/mk/vfs.mk src/lib/vfs:
+include/vfs include/ram_fs/extent.h lib/mk/vfs.mk src/lib/vfs:
 	$(mirror_from_rep_dir)
 
 LICENSE:
@@ -97,7 +97,9 @@ class Pointer::Main : public Rom::Reader
 
 		Genode::Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-		Rom::Registry _rom_registry { _sliced_heap, _env.ram(), _env.rm(), *this };
+		Rom::View_factory _views { _env };
+
+		Rom::Registry _rom_registry { _sliced_heap, _env.ram(), _env.rm(), _views, *this };
 
 		Report::Root _report_root { _env, _sliced_heap, _rom_registry, _verbose };
 
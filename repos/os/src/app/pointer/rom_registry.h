@@ -28,6 +28,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		Genode::Allocator              &_md_alloc;
 		Genode::Ram_session            &_ram;
 		Genode::Region_map             &_rm;
+		View_factory                   &_views;
 		Reader                         &_reader;
 
 		Module_list _modules { };
@@ -78,7 +79,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, session_label.prefix(), _read_write_policy,
+				Module(_md_alloc, _ram, _rm, _views, session_label.prefix(), _read_write_policy,
 				       _read_write_policy);
 
 			_modules.insert(module);
@@ -98,9 +99,10 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 		Registry(Genode::Allocator &md_alloc,
 		         Genode::Ram_session &ram, Genode::Region_map &rm,
+		         View_factory &views,
 		         Reader &reader)
 		:
-			_md_alloc(md_alloc), _ram(ram), _rm(rm), _reader(reader)
+			_md_alloc(md_alloc), _ram(ram), _rm(rm), _views(views), _reader(reader)
 		{ }
 
 		Module &lookup(Writer &writer, Module::Name const &name) override
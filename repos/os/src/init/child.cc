@@ -118,8 +118,10 @@ Init::Child::apply_config(Xml_node start_node)
 		 */
 		_binary_name = _binary_from_xml(start_node, _unique_name);
 
-		/* import new start node */
+		/* import new start node and recompile its routing rules */
+		_route_table.destruct();
 		_start_node.construct(_alloc, start_node);
+		_compile_route_table();
 	}
 
 	/*
@@ -359,6 +361,10 @@ void Init::Child::init(Pd_session &session, Pd_session_capability cap)
 
 void Init::Child::init(Cpu_session &session, Cpu_session_capability cap)
 {
+	/* children may be started concurrently by the launcher threads */
+	static Lock lock;
+	Lock::Guard guard(lock);
+
 	static size_t avail = Cpu_session::quota_lim_upscale(                    100, 100);
 	size_t const   need = Cpu_session::quota_lim_upscale(_resources.cpu_quota_pc, 100);
 	size_t need_adj = 0;
@@ -435,95 +441,146 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 		return Route { _session_requester.service(),
 		               Session::Label(), Session::Diag{false} };
 
-	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+	/*
+	 * Evaluate the compiled routing rules
+	 *
+	 * The 'Route' cannot be assigned, hence the result is kept in a
+	 * 'Constructible'.
+	 */
+	Constructible<Route> route { };
 
-		for (; ; service_node = service_node.next()) {
+	auto no_filter = [] (Service &) -> bool { return false; };
 
-			bool service_wildcard = service_node.has_type("any-service");
+	Route_table const &table = _effective_route_table();
 
-			if (!service_node_matches(service_node, label, name(), service_name))
-				continue;
+	table.for_each_rule(service_name, [&] (Route_table::Rule const &rule) {
 
-			Xml_node target = service_node.sub_node();
-			for (; ; target = target.next()) {
+		if (rule.label_dependent
+		 && !service_node_matches(rule.node, label, name(), service_name))
+			return false;
 
-				/*
-				 * Determine session label to be provided to the server
-				 *
-				 * By default, the client's identity (accompanied with the a
-				 * client-provided label) is presented as session label to the
-				 * server. However, the target node can explicitly override the
-				 * client's identity by a custom label via the 'label'
-				 * attribute.
-				 */
-				typedef String<Session_label::capacity()> Label;
-				Label const target_label =
-					target.attribute_value("label", Label(label.string()));
+		/* a service node without any target terminates the lookup */
+		if (rule.num_targets == 0)
+			return true;
 
-				Session::Diag const
-					target_diag { target.attribute_value("diag", false) };
+		table.for_each_target(rule, [&] (Route_table::Target const &target) {
 
-				auto no_filter = [] (Service &) -> bool { return false; };
+			/*
+			 * Determine session label to be provided to the server
+			 *
+			 * By default, the client's identity (accompanied with the a
+			 * client-provided label) is presented as session label to the
+			 * server. However, the target node can explicitly override the
+			 * client's identity by a custom label via the 'label'
+			 * attribute.
+			 */
+			Session::Label const target_label =
+				target.label_defined ? Session::Label(target.label.string())
+				                     : label;
 
-				if (target.has_type("parent")) {
+			switch (target.type) {
 
-					try {
-						return Route { find_service(_parent_services, service_name, no_filter),
-						               target_label, target_diag };
-					} catch (Service_denied) { }
-				}
+			case Route_table::Target::PARENT:
 
-				if (target.has_type("child")) {
+				try {
+					route.construct(Route { find_service(_parent_services, service_name, no_filter),
+					                        target_label, target.diag });
+					return true;
+				} catch (Service_denied) { }
+				break;
 
-					typedef Name_registry::Name Name;
-					Name server_name = target.attribute_value("name", Name());
-					server_name = _name_registry.deref_alias(server_name);
+			case Route_table::Target::CHILD:
+				{
+					Name_registry::Name const server_name =
+						_name_registry.deref_alias(target.server);
 
 					auto filter_server_name = [&] (Routed_service &s) -> bool {
 						return s.child_name() != server_name; };
 
 					try {
-						return Route { find_service(_child_services, service_name, filter_server_name),
-						               target_label, target_diag };
-
+						route.construct(Route { find_service(_child_services, service_name,
+						                                     filter_server_name),
+						                        target_label, target.diag });
+						return true;
 					} catch (Service_denied) { }
 				}
+				break;
 
-				if (target.has_type("any-child")) {
+			case Route_table::Target::ANY_CHILD:
 
-					if (is_ambiguous(_child_services, service_name)) {
+				if (is_ambiguous(_child_services, service_name)) {
+					if (!_routing_probe)
 						error(name(), ": ambiguous routes to "
 						      "service \"", service_name, "\"");
-						throw Service_denied();
-					}
-					try {
-						return Route { find_service(_child_services, service_name, no_filter),
-						               target_label, target_diag };
-
-					} catch (Service_denied) { }
-				}
-
-				if (!service_wildcard) {
-					warning(name(), ": lookup for service \"", service_name, "\" failed");
 					throw Service_denied();
 				}
+				try {
+					route.construct(Route { find_service(_child_services, service_name, no_filter),
+					                        target_label, target.diag });
+					return true;
+				} catch (Service_denied) { }
+				break;
+
+			case Route_table::Target::UNKNOWN:
+				break;
+			}
 
-				if (target.last())
-					break;
+			if (!rule.any_service) {
+				if (!_routing_probe)
+					warning(name(), ": lookup for service \"", service_name, "\" failed");
+				throw Service_denied();
 			}
-		}
-	} catch (Xml_node::Nonexistent_sub_node) { }
+			return false;
+		});
+
+		return route.constructed();
+	});
+
+	if (route.constructed())
+		return *route;
 
-	warning(name(), ": no route to service \"", service_name, "\"");
+	if (!_routing_probe)
+		warning(name(), ": no route to service \"", service_name, "\"");
 	throw Service_denied();
 }
 
 
+bool Init::Child::env_sessions_provided_by_parent()
+{
+	_routing_probe = true;
+
+	auto provided_by_parent = [&] (Service::Name const &service_name,
+	                               Session_label const &label,
+	                               bool              denial_accepted)
+	{
+		try {
+			Route const route = resolve_session_request(service_name, label);
+
+			bool parent = false;
+			_parent_services.for_each([&] (Parent_service const &service) {
+				if (&route.service == &service)
+					parent = true; });
+			return parent;
+		}
+		catch (Service_denied) { return denial_accepted; }
+		catch (...)            { return false; }
+	};
+
+	Service::Name const rom = Rom_session::service_name();
+
+	/* a denied route of the dynamic linker is accepted for static binaries */
+	bool const result =
+		provided_by_parent(Pd_session ::service_name(), _unique_name, false)
+	 && provided_by_parent(Cpu_session::service_name(), _unique_name, false)
+	 && provided_by_parent(Log_session::service_name(), _unique_name, false)
+	 && provided_by_parent(rom, _binary_name, false)
+	 && provided_by_parent(rom, Session_label(linker_name().string()), true);
+
+	_routing_probe = false;
+	return result;
+}
+
+
 void Init::Child::filter_session_args(Service::Name const &service,
                                       char *args, size_t args_len)
 {
@@ -664,6 +721,8 @@ Init::Child::Child(Env                      &env,
 	_child_services(child_services),
 	_session_requester(_env.ep().rpc_ep(), _env.ram(), _env.rm())
 {
+	_compile_route_table();
+
 	if (_verbose.enabled()) {
 		log("child \"",       _unique_name, "\"");
 		log("  RAM quota:  ", _resources.effective_ram_quota());
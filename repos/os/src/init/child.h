@@ -28,6 +28,7 @@
 #include <name_registry.h>
 #include <service.h>
 #include <utils.h>
+#include <route_table.h>
 
 namespace Init { class Child; }
 
@@ -46,7 +47,7 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		 */
 		struct Id { unsigned value; };
 
-		struct Default_route_accessor : Interface { virtual Xml_node default_route() = 0; };
+		struct Default_route_accessor : Interface { virtual Route_table const &default_route() = 0; };
 		struct Default_caps_accessor  : Interface { virtual Cap_quota default_caps() = 0; };
 		struct Ram_limit_accessor     : Interface { virtual Ram_quota ram_limit()    = 0; };
 
@@ -73,6 +74,27 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Reconstructible<Buffered_xml> _start_node;
 
+		/*
+		 * Routing rules of the '<route>' node, compiled whenever the start
+		 * node is imported
+		 */
+		Constructible<Route_table> _route_table { };
+
+		void _compile_route_table()
+		{
+			_route_table.destruct();
+
+			Xml_node const start_node = _start_node->xml();
+			if (start_node.has_sub_node("route"))
+				_route_table.construct(_alloc, start_node.sub_node("route"));
+		}
+
+		Route_table const &_effective_route_table()
+		{
+			return _route_table.constructed() ? *_route_table
+			                                  : _default_route_accessor.default_route();
+		}
+
 		/*
 		 * Version attribute of the start node, used to force child restarts.
 		 */
@@ -81,6 +103,11 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Default_route_accessor &_default_route_accessor;
 
+		/*
+		 * Suppress diagnostic messages while probing session routes
+		 */
+		bool _routing_probe = false;
+
 		Ram_limit_accessor &_ram_limit_accessor;
 
 		Name_registry &_name_registry;
@@ -464,6 +491,16 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 			}
 		}
 
+		bool env_sessions_pending() const { return _state == STATE_RAM_INITIALIZED; }
+
+		/**
+		 * Return true if all environment sessions are routed to init's parent
+		 *
+		 * Such a child does not depend on any other child and can be started
+		 * concurrently with other children.
+		 */
+		bool env_sessions_provided_by_parent();
+
 		void initiate_env_sessions()
 		{
 			if (_state == STATE_RAM_INITIALIZED) {
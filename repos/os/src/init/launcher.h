@@ -0,0 +1,160 @@
+/*
+ * \brief  Pool of threads for starting children in parallel
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__LAUNCHER_H_
+#define _SRC__INIT__LAUNCHER_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+
+/* local includes */
+#include <child_registry.h>
+
+namespace Init { class Launcher; }
+
+
+/**
+ * Executor of the environment-session initiation of new children
+ *
+ * Once the environment sessions of a child are available, the child's ELF
+ * binary is loaded, which involves the allocation and population of the
+ * segment dataspaces. When starting many children, this work dominates the
+ * boot time. Children whose environment sessions are provided by init's
+ * parent do not depend on any other child. Hence, the launcher performs the
+ * initiation of those children concurrently by a pool of threads while the
+ * entrypoint waits for the completion. All other children are started
+ * by the entrypoint afterwards, in the order of the configuration.
+ *
+ * The number of threads is defined by the 'launcher_threads' attribute of
+ * init's configuration. It is evaluated at the first configuration only.
+ * With a value of 1 or less, all children are started by the entrypoint.
+ */
+class Init::Launcher : Noncopyable
+{
+	private:
+
+		enum { STACK_SIZE = 16*1024*sizeof(long) };
+
+		struct Worker : Thread
+		{
+			Launcher &_launcher;
+
+			Worker(Env &env, Launcher &launcher, unsigned index)
+			:
+				Thread(env, Name("launcher.", index), STACK_SIZE,
+				       env.cpu().affinity_space().location_of_index(index),
+				       Weight(), env.cpu()),
+				_launcher(launcher)
+			{ }
+
+			void entry() override
+			{
+				for (;;)
+					_launcher._execute_job();
+			}
+		};
+
+		Env       &_env;
+		Allocator &_alloc;
+
+		unsigned const _num_workers;
+
+		Worker **_workers = nullptr;
+
+		Lock      _lock      { };
+		Semaphore _job_avail { };
+		Semaphore _job_done  { };
+
+		Child  **_jobs     = nullptr;
+		unsigned _next_job = 0;
+
+		void _execute_job()
+		{
+			_job_avail.down();
+
+			Child *child = nullptr;
+			{
+				Lock::Guard guard(_lock);
+				child = _jobs[_next_job++];
+			}
+
+			try { child->initiate_env_sessions(); }
+			catch (...) {
+				error(child->name(), ": environment initialization failed"); }
+
+			_job_done.up();
+		}
+
+		static unsigned _num_workers_from_config(Xml_node config)
+		{
+			return config.attribute_value("launcher_threads", 1U);
+		}
+
+	public:
+
+		Launcher(Env &env, Allocator &alloc, Xml_node config)
+		:
+			_env(env), _alloc(alloc),
+			_num_workers(_num_workers_from_config(config))
+		{
+			if (_num_workers <= 1)
+				return;
+
+			_workers = (Worker **)_alloc.alloc(_num_workers*sizeof(Worker *));
+
+			for (unsigned i = 0; i < _num_workers; i++) {
+				_workers[i] = new (_alloc) Worker(_env, *this, i);
+				_workers[i]->start();
+			}
+		}
+
+		/**
+		 * Initiate the environment sessions of all new children
+		 */
+		void initiate_env_sessions(Child_registry &children)
+		{
+			unsigned num_pending = 0;
+			children.for_each_child([&] (Child const &child) {
+				if (child.env_sessions_pending())
+					num_pending++; });
+
+			if (_num_workers > 1 && num_pending > 1) {
+
+				_jobs = (Child **)_alloc.alloc(num_pending*sizeof(Child *));
+
+				/* determine children that can be started independently */
+				unsigned num_jobs = 0;
+				children.for_each_child([&] (Child &child) {
+					if (child.env_sessions_pending()
+					 && child.env_sessions_provided_by_parent())
+						_jobs[num_jobs++] = &child; });
+
+				_next_job = 0;
+				for (unsigned i = 0; i < num_jobs; i++)
+					_job_avail.up();
+
+				for (unsigned i = 0; i < num_jobs; i++)
+					_job_done.down();
+
+				_alloc.free(_jobs, num_pending*sizeof(Child *));
+				_jobs = nullptr;
+			}
+
+			/* start remaining children in the order of the configuration */
+			children.for_each_child([&] (Child &child) {
+				child.initiate_env_sessions(); });
+		}
+};
+
+#endif /* _SRC__INIT__LAUNCHER_H_ */
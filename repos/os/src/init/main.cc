@@ -21,6 +21,8 @@
 #include <alias.h>
 #include <state_reporter.h>
 #include <server.h>
+#include <start_node_index.h>
+#include <launcher.h>
 
 namespace Init { struct Main; }
 
@@ -42,8 +44,17 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Reconstructible<Verbose> _verbose { _config_xml };
 
+	Launcher _launcher { _env, _heap, _config_xml };
+
 	Constructible<Buffered_xml> _default_route { };
 
+	/*
+	 * Compiled rules of the '<default-route>' node
+	 */
+	Constructible<Route_table> _default_route_table { };
+
+	Route_table const _empty_route_table { _heap, Xml_node("<empty/>") };
+
 	Cap_quota _default_caps { 0 };
 
 	unsigned _child_cnt = 0;
@@ -122,10 +133,10 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	/**
 	 * Default_route_accessor interface
 	 */
-	Xml_node default_route() override
+	Route_table const &default_route() override
 	{
-		return _default_route.constructed() ? _default_route->xml()
-		                                    : Xml_node("<empty/>");
+		return _default_route_table.constructed() ? *_default_route_table
+		                                          : _empty_route_table;
 	}
 
 	/**
@@ -138,10 +149,11 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	Signal_handler<Main> _resource_avail_handler {
 		_env.ep(), *this, &Main::_handle_resource_avail };
 
+	void _update_default_route_from_config();
 	void _update_aliases_from_config();
 	void _update_parent_services_from_config();
-	void _abandon_obsolete_children();
-	void _update_children_config();
+	void _abandon_obsolete_children(Start_node_index const &);
+	void _update_children_config(Start_node_index const &);
 	void _destroy_abandoned_parent_services();
 	void _handle_config();
 
@@ -238,24 +250,36 @@ void Init::Main::_update_aliases_from_config()
 }
 
 
-void Init::Main::_abandon_obsolete_children()
+void Init::Main::_update_default_route_from_config()
 {
-	_children.for_each_child([&] (Child &child) {
+	if (!_config_xml.has_sub_node("default-route"))
+		return;
 
-		Child_policy::Name const name = child.name();
+	Xml_node const node = _config_xml.sub_node("default-route");
 
-		bool obsolete = true;
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-			if (node.attribute_value("name", Child_policy::Name()) == name)
-				obsolete = false; });
+	/* keep the compiled rules if the default route remains unchanged */
+	if (_default_route.constructed()) {
+		Xml_node const old_node = _default_route->xml();
+		if (node.size() == old_node.size()
+		 && Genode::memcmp(node.addr(), old_node.addr(), node.size()) == 0)
+			return;
+	}
 
-		if (obsolete)
-			child.abandon();
-	});
+	_default_route_table.destruct();
+	_default_route.construct(_heap, node);
+	_default_route_table.construct(_heap, _default_route->xml());
+}
+
+
+void Init::Main::_abandon_obsolete_children(Start_node_index const &start_nodes)
+{
+	_children.for_each_child([&] (Child &child) {
+		if (!start_nodes.exists(child.name()))
+			child.abandon(); });
 }
 
 
-void Init::Main::_update_children_config()
+void Init::Main::_update_children_config(Start_node_index const &start_nodes)
 {
 	for (;;) {
 
@@ -267,18 +291,12 @@ void Init::Main::_update_children_config()
 		 */
 		bool side_effects = false;
 
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-
-			Child_policy::Name const start_node_name =
-				node.attribute_value("name", Child_policy::Name());
-
-			_children.for_each_child([&] (Child &child) {
-				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
+		_children.for_each_child([&] (Child &child) {
+			start_nodes.with_start_node(child.name(), [&] (Xml_node node) {
+				switch (child.apply_config(node)) {
+				case Child::NO_SIDE_EFFECTS: break;
+				case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
+				};
 			});
 		});
 
@@ -298,8 +316,7 @@ void Init::Main::_handle_config()
 	_state_reporter.apply_config(_config_xml);
 
 	/* determine default route for resolving service requests */
-	try {
-		_default_route.construct(_heap, _config_xml.sub_node("default-route")); }
+	try { _update_default_route_from_config(); }
 	catch (...) { }
 
 	_default_caps = Cap_quota { 0 };
@@ -313,8 +330,11 @@ void Init::Main::_handle_config()
 
 	_update_aliases_from_config();
 	_update_parent_services_from_config();
-	_abandon_obsolete_children();
-	_update_children_config();
+
+	Start_node_index start_nodes(_heap, _config_xml);
+
+	_abandon_obsolete_children(start_nodes);
+	_update_children_config(start_nodes);
 
 	/* kill abandoned children */
 	_children.for_each_child([&] (Child &child) {
@@ -326,6 +346,9 @@ void Init::Main::_handle_config()
 
 	_destroy_abandoned_parent_services();
 
+	_children.for_each_child([&] (Child const &child) {
+		start_nodes.mark_child_exists(child.name()); });
+
 	/* initial RAM and caps limit before starting new children */
 	Ram_quota const avail_ram  = _avail_ram();
 	Cap_quota const avail_caps = _avail_caps();
@@ -338,14 +361,12 @@ void Init::Main::_handle_config()
 	try {
 		_config_xml.for_each_sub_node("start", [&] (Xml_node start_node) {
 
+			Child_policy::Name const name =
+				start_node.attribute_value("name", Child_policy::Name());
+
 			/* skip start node if corresponding child already exists */
-			bool exists = false;
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name()))
-					exists = true; });
-			if (exists) {
+			if (start_nodes.child_exists(name))
 				return;
-			}
 
 			if (used_ram.value > avail_ram.value) {
 				error("RAM exhausted while starting childen");
@@ -367,6 +388,7 @@ void Init::Main::_handle_config()
 					             *this, prio_levels, affinity_space,
 					            _parent_services, _child_services);
 				_children.insert(&child);
+				start_nodes.mark_child_exists(name);
 
 				/* account for the start XML node buffered in the child */
 				size_t const metadata_overhead = start_node.size()
@@ -414,8 +436,7 @@ void Init::Main::_handle_config()
 	/*
 	 * Initiate remaining environment sessions of all new children
 	 */
-	_children.for_each_child([&] (Child &child) {
-		child.initiate_env_sessions(); });
+	_launcher.initiate_env_sessions(_children);
 
 	/*
 	 * (Re-)distribute RAM among the childen, given their resource assignments
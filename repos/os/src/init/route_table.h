@@ -0,0 +1,282 @@
+/*
+ * \brief  Session-routing rules compiled from a route node
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__ROUTE_TABLE_H_
+#define _SRC__INIT__ROUTE_TABLE_H_
+
+/* Genode includes */
+#include <base/child.h>
+#include <util/reconstructible.h>
+
+/* local includes */
+#include <types.h>
+
+namespace Init { class Route_table; }
+
+
+/**
+ * Pre-processed representation of a '<route>' or '<default-route>' node
+ *
+ * Resolving a session request used to walk the XML of the route node and
+ * re-parse the attributes of each service and target node. With many
+ * children and many session requests, this parsing dominated the work of
+ * init. The route table is compiled once whenever the route node changes.
+ * Its rules are indexed by service name such that a lookup visits only the
+ * rules that can possibly match the requested service, in the order of the
+ * original route node. Only the label conditions of a rule still refer to
+ * the XML node because they depend on the label of each individual request.
+ *
+ * The table refers to the XML node it was compiled from, which must remain
+ * valid during the lifetime of the table.
+ */
+class Init::Route_table : Noncopyable
+{
+	public:
+
+		typedef String<Session_label::capacity()> Label;
+
+		struct Target
+		{
+			enum Type { PARENT, CHILD, ANY_CHILD, UNKNOWN };
+
+			Type               type;
+			Child_policy::Name server;         /* 'name' of a child target */
+			bool               label_defined;  /* overrides client label  */
+			Label              label;
+			Session::Diag      diag;
+
+			Target(Xml_node node)
+			:
+				type(node.has_type("parent")    ? PARENT    :
+				     node.has_type("child")     ? CHILD     :
+				     node.has_type("any-child") ? ANY_CHILD : UNKNOWN),
+				server(node.attribute_value("name", Child_policy::Name())),
+				label_defined(node.has_attribute("label")),
+				label(node.attribute_value("label", Label())),
+				diag(Session::Diag { node.attribute_value("diag", false) })
+			{ }
+		};
+
+		struct Rule
+		{
+			Xml_node      const node;
+			bool          const any_service;
+			Service::Name const service;
+
+			/**
+			 * True if the rule must be matched against the session label
+			 */
+			bool const label_dependent;
+
+			unsigned const first_target;
+			unsigned const num_targets;
+
+			Rule(Xml_node node, unsigned first_target, unsigned num_targets)
+			:
+				node(node),
+				any_service(node.has_type("any-service")),
+				service(node.attribute_value("name", Service::Name())),
+				label_dependent(node.has_attribute("label")
+				             || node.has_attribute("label_prefix")
+				             || node.has_attribute("label_suffix")
+				             || node.has_attribute("unscoped_label")),
+				first_target(first_target), num_targets(num_targets)
+			{ }
+		};
+
+	private:
+
+		/**
+		 * Sequence of rules to consider for a service
+		 */
+		struct Sequence
+		{
+			Service::Name name  { };
+			unsigned      first = 0;  /* index into '_rule_indices' */
+			unsigned      count = 0;
+		};
+
+		Allocator &_alloc;
+
+		unsigned _num_rules     = 0;
+		unsigned _num_targets   = 0;
+		unsigned _num_services  = 0;
+		unsigned _num_indices   = 0;
+
+		Rule     *_rules        = nullptr;
+		Target   *_targets      = nullptr;
+		Sequence *_services     = nullptr;
+		unsigned *_rule_indices = nullptr;
+
+		/**
+		 * Rules to consider for services not mentioned explicitly
+		 */
+		Sequence _any_service { };
+
+		static bool _service_node(Xml_node node)
+		{
+			return node.has_type("service") || node.has_type("any-service");
+		}
+
+		template <typename T>
+		T *_alloc_array(unsigned n)
+		{
+			return n ? (T *)_alloc.alloc(n*sizeof(T)) : nullptr;
+		}
+
+		template <typename T>
+		void _free_array(T *array, unsigned n)
+		{
+			if (array)
+				_alloc.free(array, n*sizeof(T));
+		}
+
+		void _free()
+		{
+			_free_array(_rules,        _num_rules);
+			_free_array(_targets,      _num_targets);
+			_free_array(_services,     _num_services);
+			_free_array(_rule_indices, _num_indices);
+		}
+
+		bool _service_known(Service::Name const &name, unsigned n) const
+		{
+			for (unsigned i = 0; i < n; i++)
+				if (_services[i].name == name)
+					return true;
+			return false;
+		}
+
+		void _compile(Xml_node route)
+		{
+			route.for_each_sub_node([&] (Xml_node node) {
+				if (!_service_node(node))
+					return;
+				_num_rules++;
+				node.for_each_sub_node([&] (Xml_node) { _num_targets++; });
+			});
+
+			_rules   = _alloc_array<Rule>  (_num_rules);
+			_targets = _alloc_array<Target>(_num_targets);
+
+			unsigned rule_cnt = 0, target_cnt = 0, any_service_cnt = 0;
+			route.for_each_sub_node([&] (Xml_node node) {
+				if (!_service_node(node))
+					return;
+
+				unsigned const first_target = target_cnt;
+				node.for_each_sub_node([&] (Xml_node target) {
+					construct_at<Target>(&_targets[target_cnt++], target); });
+
+				construct_at<Rule>(&_rules[rule_cnt++], node, first_target,
+				                   target_cnt - first_target);
+			});
+
+			/* determine number of distinct service names */
+			for (unsigned i = 0; i < _num_rules; i++) {
+
+				if (_rules[i].any_service) {
+					any_service_cnt++;
+					continue;
+				}
+
+				bool first_occurrence = true;
+				for (unsigned j = 0; j < i; j++)
+					if (!_rules[j].any_service && _rules[j].service == _rules[i].service)
+						first_occurrence = false;
+
+				if (first_occurrence)
+					_num_services++;
+			}
+
+			_services     = _alloc_array<Sequence>(_num_services);
+			_num_indices  = any_service_cnt*(_num_services + 1)
+			              + (_num_rules - any_service_cnt);
+			_rule_indices = _alloc_array<unsigned>(_num_indices);
+
+			unsigned index_cnt = 0;
+
+			auto fill_sequence = [&] (Sequence &seq, bool named) {
+				seq.first = index_cnt;
+				for (unsigned i = 0; i < _num_rules; i++)
+					if (_rules[i].any_service
+					 || (named && _rules[i].service == seq.name))
+						_rule_indices[index_cnt++] = i;
+				seq.count = index_cnt - seq.first;
+			};
+
+			unsigned service_cnt = 0;
+			for (unsigned i = 0; i < _num_rules; i++) {
+				Rule const &rule = _rules[i];
+				if (rule.any_service)
+					continue;
+
+				if (_service_known(rule.service, service_cnt))
+					continue;
+
+				Sequence &seq = *construct_at<Sequence>(&_services[service_cnt++]);
+				seq.name = rule.service;
+				fill_sequence(seq, true);
+			}
+
+			fill_sequence(_any_service, false);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Route_table(Allocator &alloc, Xml_node route) : _alloc(alloc)
+		{
+			try { _compile(route); }
+			catch (...) { _free(); throw; }
+		}
+
+		~Route_table() { _free(); }
+
+		/**
+		 * Call 'fn' for each rule that applies to the specified service
+		 *
+		 * The rules are visited in the order of the route node. The
+		 * iteration stops as soon as 'fn' returns true.
+		 */
+		template <typename FN>
+		void for_each_rule(Service::Name const &service, FN const &fn) const
+		{
+			Sequence const *seq = &_any_service;
+			for (unsigned i = 0; i < _num_services; i++)
+				if (_services[i].name == service)
+					seq = &_services[i];
+
+			for (unsigned i = 0; i < seq->count; i++)
+				if (fn(_rules[_rule_indices[seq->first + i]]))
+					return;
+		}
+
+		/**
+		 * Call 'fn' for each target of a rule until 'fn' returns true
+		 */
+		template <typename FN>
+		void for_each_target(Rule const &rule, FN const &fn) const
+		{
+			for (unsigned i = 0; i < rule.num_targets; i++)
+				if (fn(_targets[rule.first_target + i]))
+					return;
+		}
+};
+
+#endif /* _SRC__INIT__ROUTE_TABLE_H_ */
@@ -0,0 +1,137 @@
+/*
+ * \brief  Lookup of '<start>' nodes by child name
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__START_NODE_INDEX_H_
+#define _SRC__INIT__START_NODE_INDEX_H_
+
+/* Genode includes */
+#include <util/avl_tree.h>
+
+/* local includes */
+#include <types.h>
+
+namespace Init { class Start_node_index; }
+
+
+/**
+ * Index of the start nodes of a config, keyed by the child name
+ *
+ * The index is built once per config update and replaces the scanning of
+ * all start nodes for each child. If the config contains multiple start
+ * nodes of the same name, the first one is indexed.
+ */
+class Init::Start_node_index : Noncopyable
+{
+	private:
+
+		struct Entry : Avl_node<Entry>
+		{
+			Child_policy::Name const name;
+			Xml_node           const node;
+
+			bool child_exists = false;
+
+			Entry(Xml_node node)
+			:
+				name(node.attribute_value("name", Child_policy::Name())),
+				node(node)
+			{ }
+
+			/**
+			 * Avl_node interface
+			 */
+			bool higher(Entry *e) {
+				return strcmp(e->name.string(), name.string()) > 0; }
+
+			Entry *find(Child_policy::Name const &child_name)
+			{
+				int const cmp = strcmp(child_name.string(), name.string());
+				if (cmp == 0)
+					return this;
+
+				Entry *e = Avl_node<Entry>::child(cmp > 0);
+				return e ? e->find(child_name) : nullptr;
+			}
+		};
+
+		Allocator &_alloc;
+
+		Avl_tree<Entry> _tree { };
+
+		Entry *_lookup(Child_policy::Name const &name) const
+		{
+			Entry *root = _tree.first();
+			return root ? root->find(name) : nullptr;
+		}
+
+		void _destroy_entries()
+		{
+			while (Entry *e = _tree.first()) {
+				_tree.remove(e);
+				destroy(_alloc, e);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Start_node_index(Allocator &alloc, Xml_node config) : _alloc(alloc)
+		{
+			try {
+				config.for_each_sub_node("start", [&] (Xml_node node) {
+					Child_policy::Name const name =
+						node.attribute_value("name", Child_policy::Name());
+					if (!_lookup(name))
+						_tree.insert(new (_alloc) Entry(node));
+				});
+			}
+			catch (...) { _destroy_entries(); throw; }
+		}
+
+		~Start_node_index() { _destroy_entries(); }
+
+		bool exists(Child_policy::Name const &name) const {
+			return _lookup(name) != nullptr; }
+
+		/**
+		 * Call 'fn' with the start node of the named child, if present
+		 */
+		template <typename FN>
+		void with_start_node(Child_policy::Name const &name, FN const &fn) const
+		{
+			if (Entry const *e = _lookup(name))
+				fn(e->node);
+		}
+
+		/**
+		 * Mark the start node of the named child as instantiated
+		 */
+		void mark_child_exists(Child_policy::Name const &name)
+		{
+			if (Entry *e = _lookup(name))
+				e->child_exists = true;
+		}
+
+		bool child_exists(Child_policy::Name const &name) const
+		{
+			Entry const *e = _lookup(name);
+			return e && e->child_exists;
+		}
+};
+
+#endif /* _SRC__INIT__START_NODE_INDEX_H_ */
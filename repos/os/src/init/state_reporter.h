@@ -63,11 +63,19 @@ class Init::State_reporter : public Report_update_trigger
 		Signal_handler<State_reporter> _timer_periodic_handler {
 			_env.ep(), *this, &State_reporter::_handle_timer };
 
+		/*
+		 * Report updates may be triggered by the launcher threads
+		 */
+		Lock _trigger_lock { };
+
 		bool _scheduled = false;
 
 		void _handle_timer()
 		{
-			_scheduled = false;
+			{
+				Lock::Guard guard(_trigger_lock);
+				_scheduled = false;
+			}
 
 			try {
 				Reporter::Xml_generator xml(*_reporter, [&] () {
@@ -178,6 +186,8 @@ class Init::State_reporter : public Report_update_trigger
 
 		void trigger_report_update() override
 		{
+			Lock::Guard guard(_trigger_lock);
+
 			if (!_scheduled && _timer.constructed() && _report_delay_ms) {
 				_timer->trigger_once(_report_delay_ms*1000);
 				_scheduled = true;
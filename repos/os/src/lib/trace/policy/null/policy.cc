@@ -37,3 +37,7 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 	return 0;
 }
 
+size_t lock_contended(char *dst, Lock_stats const &)
+{
+	return 0;
+}
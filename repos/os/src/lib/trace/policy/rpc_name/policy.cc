@@ -1,9 +1,10 @@
 #include <util/string.h>
+#include <base/lock_stats.h>
 #include <trace/policy.h>
 
 using namespace Genode;
 
-enum { MAX_EVENT_SIZE = 64 };
+enum { MAX_EVENT_SIZE = 128 };
 
 size_t max_event_size()
 {
@@ -51,3 +52,48 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+/*
+ * The policy module is not linked against the base library. Hence, the
+ * numbers are formatted manually.
+ */
+static size_t append(char *dst, size_t len, char const *s)
+{
+	for (; *s && len < MAX_EVENT_SIZE; s++)
+		dst[len++] = *s;
+	return len;
+}
+
+static size_t append(char *dst, size_t len, unsigned long long value)
+{
+	char digits[20];
+	unsigned n = 0;
+	do {
+		digits[n++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+
+	while (n && len < MAX_EVENT_SIZE)
+		dst[len++] = digits[--n];
+	return len;
+}
+
+size_t lock_contended(char *dst, Lock_stats const &stats)
+{
+	size_t len = append(dst, 0, stats.name);
+
+	len = append(dst, len, " acquisitions=");
+	len = append(dst, len, stats.acquisitions);
+	len = append(dst, len, " contended=");
+	len = append(dst, len, stats.contended);
+	len = append(dst, len, " blocked=");
+	len = append(dst, len, stats.blocked);
+	len = append(dst, len, " spins=");
+	len = append(dst, len, stats.spins);
+
+	if (stats.timestamp) {
+		len = append(dst, len, " wait_time=");
+		len = append(dst, len, stats.wait_time);
+	}
+	return len;
+}
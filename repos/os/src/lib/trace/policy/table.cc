@@ -24,6 +24,7 @@ extern "C" {
 		rpc_dispatch,
 		rpc_reply,
 		signal_submit,
-		signal_receive
+		signal_receive,
+		lock_contended
 	};
 }
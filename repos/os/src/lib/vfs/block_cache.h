@@ -0,0 +1,384 @@
+/*
+ * \brief  Write-back cache of device blocks
+ * \author Genode Labs
+ * \date   2026-10-19
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__VFS__BLOCK_CACHE_H_
+#define _INCLUDE__VFS__BLOCK_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <block_session/block_session.h>
+#include <util/construct_at.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Vfs { class Block_cache; }
+
+
+/**
+ * Write-back cache of device blocks
+ *
+ * The cache holds a fixed number of blocks, which are replaced in
+ * least-recently-used order. Dirty blocks are written back when
+ * evicted and on 'sync'. Adjacent dirty blocks are merged into one
+ * request, and a cache miss reads the following uncached blocks of
+ * the same request along with the missing block.
+ *
+ * The I/O is performed by the 'IO' functor passed to each
+ * operation, which is called with the first block number, a
+ * buffer, the number of blocks, and the direction.
+ */
+class Vfs::Block_cache : Genode::Noncopyable
+{
+	private:
+
+		enum { MAX_RUN_BYTES = 64*1024 };
+
+		struct Entry
+		{
+			Block::sector_t nr        = 0;
+			bool            valid     = false;
+			bool            dirty     = false;
+			Entry          *lru_prev  = nullptr;
+			Entry          *lru_next  = nullptr;
+			Entry          *hash_next = nullptr;
+			char           *data      = nullptr;
+		};
+
+		Genode::Allocator    &_alloc;
+		Genode::size_t const  _block_size;
+		unsigned       const  _num_entries;
+		unsigned       const  _max_run;
+		unsigned       const  _num_buckets;
+
+		Entry  * const _entries;
+		Entry ** const _buckets;
+		char   * const _data;
+		char   * const _run_buffer;
+
+		/* the head of the LRU list is the most recently used entry */
+		Entry *_lru_head = nullptr;
+		Entry *_lru_tail = nullptr;
+
+		Genode::Lock _lock { };
+
+		static unsigned _power_of_two(unsigned n)
+		{
+			unsigned result = 1;
+			while (result < n)
+				result <<= 1;
+			return result;
+		}
+
+		Entry *&_bucket(Block::sector_t nr) {
+			return _buckets[nr & (_num_buckets - 1)]; }
+
+		Entry *_lookup(Block::sector_t nr)
+		{
+			for (Entry *e = _bucket(nr); e; e = e->hash_next)
+				if (e->nr == nr)
+					return e;
+			return nullptr;
+		}
+
+		void _hash_remove(Entry &entry)
+		{
+			for (Entry **e = &_bucket(entry.nr); *e; e = &(*e)->hash_next) {
+				if (*e == &entry) {
+					*e = entry.hash_next;
+					break;
+				}
+			}
+			entry.hash_next = nullptr;
+		}
+
+		void _lru_remove(Entry &entry)
+		{
+			if (entry.lru_prev) entry.lru_prev->lru_next = entry.lru_next;
+			else                _lru_head                = entry.lru_next;
+
+			if (entry.lru_next) entry.lru_next->lru_prev = entry.lru_prev;
+			else                _lru_tail                = entry.lru_prev;
+
+			entry.lru_prev = entry.lru_next = nullptr;
+		}
+
+		void _lru_push_front(Entry &entry)
+		{
+			entry.lru_prev = nullptr;
+			entry.lru_next = _lru_head;
+
+			if (_lru_head) _lru_head->lru_prev = &entry;
+			else           _lru_tail           = &entry;
+
+			_lru_head = &entry;
+		}
+
+		void _touch(Entry &entry)
+		{
+			_lru_remove(entry);
+			_lru_push_front(entry);
+		}
+
+		void _invalidate(Entry &entry)
+		{
+			_hash_remove(entry);
+			entry.valid = false;
+			entry.dirty = false;
+		}
+
+		/**
+		 * Write back dirty entry along with adjacent dirty entries
+		 */
+		template <typename IO>
+		bool _flush_run(Entry &entry, IO const &io)
+		{
+			Block::sector_t first = entry.nr;
+			unsigned        count = 1;
+
+			for (; first > 0 && count < _max_run; first--, count++) {
+				Entry *e = _lookup(first - 1);
+				if (!e || !e->dirty)
+					break;
+			}
+
+			for (; count < _max_run; count++) {
+				Entry *e = _lookup(first + count);
+				if (!e || !e->dirty)
+					break;
+			}
+
+			for (unsigned i = 0; i < count; i++)
+				Genode::memcpy(_run_buffer + i*_block_size,
+				               _lookup(first + i)->data, _block_size);
+
+			if (!io(first, _run_buffer, count, true))
+				return false;
+
+			for (unsigned i = 0; i < count; i++)
+				_lookup(first + i)->dirty = false;
+
+			return true;
+		}
+
+		/**
+		 * Assign least-recently-used entry to block 'nr'
+		 *
+		 * The content of the returned entry is undefined unless the
+		 * block was already cached.
+		 *
+		 * If the least-recently-used entry is dirty and cannot be
+		 * written back, it stays cached for a later retry and the
+		 * least-recently-used clean entry is evicted instead.
+		 *
+		 * \return nullptr if no entry could be evicted
+		 */
+		template <typename IO>
+		Entry *_claim(Block::sector_t nr, IO const &io)
+		{
+			if (Entry *e = _lookup(nr)) {
+				_touch(*e);
+				return e;
+			}
+
+			Entry *victim = _lru_tail;
+
+			if (victim->dirty && !_flush_run(*victim, io)) {
+
+				/* retry the write-back not before the other entries aged */
+				_touch(*victim);
+
+				victim = nullptr;
+				for (Entry *e = _lru_tail; e && !victim; e = e->lru_prev)
+					if (!e->dirty)
+						victim = e;
+
+				if (!victim)
+					return nullptr;
+			}
+
+			Entry &victim_entry = *victim;
+
+			if (victim_entry.valid)
+				_invalidate(victim_entry);
+
+			victim_entry.nr        = nr;
+			victim_entry.valid     = true;
+			victim_entry.hash_next = _bucket(nr);
+			_bucket(nr)            = &victim_entry;
+
+			_touch(victim_entry);
+			return &victim_entry;
+		}
+
+		/**
+		 * Read block 'nr' and up to 'count - 1' subsequent uncached
+		 * blocks into the cache
+		 */
+		template <typename IO>
+		Entry *_fill(Block::sector_t nr, Block::sector_t count, IO const &io)
+		{
+			unsigned n = 1;
+			while (n < count && n < _max_run && !_lookup(nr + n))
+				n++;
+
+			bool claimed = true;
+			for (unsigned i = 0; i < n && claimed; i++)
+				claimed = (_claim(nr + i, io) != nullptr);
+
+			/*
+			 * If most entries are dirty and cannot be written back,
+			 * a claim may evict an entry claimed just before.
+			 */
+			for (unsigned i = 0; i < n && claimed; i++)
+				claimed = (_lookup(nr + i) != nullptr);
+
+			if (!claimed) {
+				for (unsigned i = 0; i < n; i++)
+					if (Entry *e = _lookup(nr + i))
+						if (!e->dirty)
+							_invalidate(*e);
+				return nullptr;
+			}
+
+			if (!io(nr, _run_buffer, n, false)) {
+				for (unsigned i = 0; i < n; i++)
+					_invalidate(*_lookup(nr + i));
+				return nullptr;
+			}
+
+			for (unsigned i = 0; i < n; i++)
+				Genode::memcpy(_lookup(nr + i)->data,
+				               _run_buffer + i*_block_size, _block_size);
+
+			return _lookup(nr);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_entries  number of cached blocks, at least 1
+		 */
+		Block_cache(Genode::Allocator &alloc, Genode::size_t block_size,
+		            unsigned num_entries)
+		:
+			_alloc(alloc), _block_size(block_size),
+			_num_entries(num_entries),
+			_max_run(Genode::max((Genode::size_t)1,
+			                     Genode::min(MAX_RUN_BYTES/block_size,
+			                                 (Genode::size_t)num_entries/2))),
+			_num_buckets(_power_of_two(num_entries)),
+			_entries((Entry *)alloc.alloc(num_entries*sizeof(Entry))),
+			_buckets((Entry **)alloc.alloc(_num_buckets*sizeof(Entry *))),
+			_data((char *)alloc.alloc(num_entries*block_size)),
+			_run_buffer((char *)alloc.alloc(_max_run*block_size))
+		{
+			for (unsigned i = 0; i < _num_buckets; i++)
+				_buckets[i] = nullptr;
+
+			for (unsigned i = 0; i < _num_entries; i++) {
+				Entry &entry = *Genode::construct_at<Entry>(&_entries[i]);
+				entry.data = _data + i*_block_size;
+				_lru_push_front(entry);
+			}
+		}
+
+		~Block_cache()
+		{
+			_alloc.free(_run_buffer, _max_run*_block_size);
+			_alloc.free(_data,       _num_entries*_block_size);
+			_alloc.free(_buckets,    _num_buckets*sizeof(Entry *));
+			_alloc.free(_entries,    _num_entries*sizeof(Entry));
+		}
+
+		/**
+		 * Maximum number of blocks transferred by one request
+		 */
+		unsigned max_run() const { return _max_run; }
+
+		/**
+		 * Read 'len' bytes at 'offset' within block 'nr'
+		 *
+		 * \param count  number of blocks starting at 'nr' covered by
+		 *               the read request, used to read ahead on a
+		 *               cache miss
+		 */
+		template <typename IO>
+		bool read(Block::sector_t nr, Block::sector_t count,
+		          Genode::size_t offset, char *dst, Genode::size_t len,
+		          IO const &io)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Entry *entry = _lookup(nr);
+			if (entry)
+				_touch(*entry);
+			else
+				entry = _fill(nr, count, io);
+
+			if (!entry)
+				return false;
+
+			Genode::memcpy(dst, entry->data + offset, len);
+			return true;
+		}
+
+		/**
+		 * Write 'len' bytes at 'offset' within block 'nr'
+		 *
+		 * A partially written block is read from the device first
+		 * unless it is already cached.
+		 */
+		template <typename IO>
+		bool write(Block::sector_t nr, Genode::size_t offset,
+		           char const *src, Genode::size_t len, IO const &io)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Entry *entry = _lookup(nr);
+			if (entry)
+				_touch(*entry);
+			else if (offset == 0 && len == _block_size)
+				entry = _claim(nr, io);
+			else
+				entry = _fill(nr, 1, io);
+
+			if (!entry)
+				return false;
+
+			Genode::memcpy(entry->data + offset, src, len);
+			entry->dirty = true;
+			return true;
+		}
+
+		/**
+		 * Write back all dirty blocks
+		 */
+		template <typename IO>
+		bool sync(IO const &io)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			bool result = true;
+			for (unsigned i = 0; i < _num_entries; i++) {
+				Entry &entry = _entries[i];
+				if (entry.valid && entry.dirty && !_flush_run(entry, io))
+					result = false;
+			}
+			return result;
+		}
+};
+
+#endif /* _INCLUDE__VFS__BLOCK_CACHE_H_ */
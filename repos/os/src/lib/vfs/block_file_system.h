@@ -16,9 +16,14 @@
 #define _INCLUDE__VFS__BLOCK_FILE_SYSTEM_H_
 
 #include <base/allocator_avl.h>
+#include <util/construct_at.h>
+#include <util/reconstructible.h>
 #include <block_session/connection.h>
 #include <vfs/single_file_system.h>
 
+/* local includes */
+#include "block_cache.h"
+
 namespace Vfs { class Block_file_system; }
 
 
@@ -59,6 +64,8 @@ class Vfs::Block_file_system : public Single_file_system
 		Block_file_system(Block_file_system const &);
 		Block_file_system &operator = (Block_file_system const &);
 
+		Genode::Constructible<Block_cache> _cache { };
+
 		class Block_vfs_handle : public Single_vfs_handle
 		{
 			private:
@@ -79,6 +86,7 @@ class Vfs::Block_file_system : public Single_file_system
 				Genode::Signal_receiver           &_signal_receiver;
 				Genode::Signal_context            &_signal_context;
 				Genode::Signal_context_capability &_source_submit_cap;
+				Block_cache                       *_cache;
 
 				/*
 				 * Noncopyable
@@ -98,9 +106,12 @@ class Vfs::Block_file_system : public Single_file_system
 					Block::Packet_descriptor packet;
 
 					/* sanity check */
-					if (packet_count > _block_buffer_count) {
-						packet_size  = _block_buffer_count * _block_size;
-						packet_count = _block_buffer_count;
+					file_size const max_count =
+						Genode::max(_block_buffer_count, _cache ? _cache->max_run() : 0U);
+
+					if (packet_count > max_count) {
+						packet_size  = max_count * _block_size;
+						packet_count = max_count;
 					}
 
 					while (true) {
@@ -143,6 +154,94 @@ class Vfs::Block_file_system : public Single_file_system
 					return packet_size;
 				}
 
+				/**
+				 * Transfer 'sz' bytes starting at block 'nr' using as many
+				 * packets as needed
+				 */
+				bool _block_io_all(file_size nr, char *buf, file_size sz, bool write)
+				{
+					while (sz > 0) {
+						file_size const nbytes = _block_io(nr, buf, sz, write, true);
+						if (nbytes == 0)
+							return false;
+
+						nr  += nbytes / _block_size;
+						buf += nbytes;
+						sz  -= nbytes;
+					}
+					return true;
+				}
+
+				/**
+				 * Block I/O functor used by the block cache
+				 */
+				struct Cache_io
+				{
+					Block_vfs_handle &handle;
+
+					bool operator () (Block::sector_t nr, char *buf,
+					                  unsigned count, bool write) const
+					{
+						return handle._block_io_all(nr, buf, count*handle._block_size, write);
+					}
+				};
+
+				Read_result _cached_read(char *dst, file_size count,
+				                         file_size &out_count)
+				{
+					file_size seek_offset = seek();
+					file_size read        = 0;
+
+					while (read < count) {
+						Block::sector_t const nr     = seek_offset / _block_size;
+						file_size       const displ  = seek_offset % _block_size;
+						file_size       const length = Genode::min(count - read,
+						                                           _block_size - displ);
+
+						/* number of blocks covered by the remaining request */
+						Block::sector_t const blocks =
+							(seek_offset + (count - read) - 1) / _block_size - nr + 1;
+
+						if (!_cache->read(nr, blocks, displ, dst + read, length,
+						                  Cache_io { *this })) {
+							Genode::error("error while reading block:", nr, " from block device");
+							return READ_ERR_INVALID;
+						}
+
+						read        += length;
+						seek_offset += length;
+					}
+
+					out_count = read;
+					return READ_OK;
+				}
+
+				Write_result _cached_write(char const *buf, file_size count,
+				                           file_size &out_count)
+				{
+					file_size seek_offset = seek();
+					file_size written     = 0;
+
+					while (written < count) {
+						Block::sector_t const nr     = seek_offset / _block_size;
+						file_size       const displ  = seek_offset % _block_size;
+						file_size       const length = Genode::min(count - written,
+						                                           _block_size - displ);
+
+						if (!_cache->write(nr, displ, buf + written, length,
+						                   Cache_io { *this })) {
+							Genode::error("error while writing block:", nr, " to block device");
+							return WRITE_ERR_INVALID;
+						}
+
+						written     += length;
+						seek_offset += length;
+					}
+
+					out_count = written;
+					return WRITE_OK;
+				}
+
 			public:
 
 				Block_vfs_handle(Directory_service                 &ds,
@@ -162,7 +261,8 @@ class Vfs::Block_file_system : public Single_file_system
 				                 bool                              &writeable,
 				                 Genode::Signal_receiver           &signal_receiver,
 				                 Genode::Signal_context            &signal_context,
-				                 Genode::Signal_context_capability &source_submit_cap)
+				                 Genode::Signal_context_capability &source_submit_cap,
+				                 Block_cache                       *cache)
 				: Single_vfs_handle(ds, fs, alloc, 0),
 				  _alloc(alloc),
 				  _label(label),
@@ -179,7 +279,8 @@ class Vfs::Block_file_system : public Single_file_system
 				  _writeable(writeable),
 				  _signal_receiver(signal_receiver),
 				  _signal_context(signal_context),
-				  _source_submit_cap(source_submit_cap)
+				  _source_submit_cap(source_submit_cap),
+				  _cache(cache)
 				{ }
 
 				Read_result read(char *dst, file_size count,
@@ -190,6 +291,9 @@ class Vfs::Block_file_system : public Single_file_system
 						return READ_ERR_INVALID;
 					}
 
+					if (_cache)
+						return _cached_read(dst, count, out_count);
+
 					file_size seek_offset = seek();
 
 					file_size read = 0;
@@ -258,6 +362,9 @@ class Vfs::Block_file_system : public Single_file_system
 						return WRITE_ERR_INVALID;
 					}
 
+					if (_cache)
+						return _cached_write(buf, count, out_count);
+
 					file_size seek_offset = seek();
 
 					file_size written = 0;
@@ -330,6 +437,14 @@ class Vfs::Block_file_system : public Single_file_system
 				}
 
 				bool read_ready() { return true; }
+
+				/**
+				 * Write back the dirty blocks of the cache
+				 */
+				bool sync()
+				{
+					return !_cache || _cache->sync(Cache_io { *this });
+				}
 		};
 
 	public:
@@ -360,6 +475,10 @@ class Vfs::Block_file_system : public Single_file_system
 
 			_block_buffer = new (_alloc) char[_block_buffer_count * _block_size];
 
+			unsigned const cache_blocks = config.attribute_value("cache_blocks", 0U);
+			if (cache_blocks)
+				_cache.construct(_alloc, _block_size, cache_blocks);
+
 			_block.tx_channel()->sigh_ready_to_submit(_source_submit_cap);
 		}
 
@@ -398,10 +517,24 @@ class Vfs::Block_file_system : public Single_file_system
 			                                           _writeable,
 			                                           _signal_receiver,
 			                                           _signal_context,
-			                                           _source_submit_cap);
+			                                           _source_submit_cap,
+			                                           _cache.constructed() ? &*_cache : nullptr);
 			return OPEN_OK;
 		}
 
+		void close(Vfs_handle *vfs_handle) override
+		{
+			/*
+			 * Write back all dirty blocks of the cache, which is shared by
+			 * all handles
+			 */
+			if (Block_vfs_handle *handle = dynamic_cast<Block_vfs_handle *>(vfs_handle))
+				if (!handle->sync())
+					Genode::error("could not write back cached blocks");
+
+			Single_file_system::close(vfs_handle);
+		}
+
 		Stat_result stat(char const *path, Stat &out) override
 		{
 			Stat_result const result = Single_file_system::stat(path, out);
@@ -419,6 +552,15 @@ class Vfs::Block_file_system : public Single_file_system
 			return FTRUNCATE_OK;
 		}
 
+		Sync_result complete_sync(Vfs_handle *vfs_handle) override
+		{
+			if (Block_vfs_handle *handle = dynamic_cast<Block_vfs_handle *>(vfs_handle))
+				if (!handle->sync())
+					Genode::error("could not write back cached blocks");
+
+			return SYNC_OK;
+		}
+
 		Ioctl_result ioctl(Vfs_handle *, Ioctl_opcode opcode, Ioctl_arg,
 		                   Ioctl_out &out) override
 		{
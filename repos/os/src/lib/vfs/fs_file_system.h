@@ -49,8 +49,86 @@ class Vfs::Fs_file_system : public File_system
 		typedef Genode::String<::File_system::MAX_NAME_LEN> Root_string;
 		Root_string _root;
 
+		/* size of the readahead window for sequential reads */
+		file_size const _readahead;
+
+		/**
+		 * Bulk-buffer space available for the readahead of all handles
+		 *
+		 * The readahead packets of a closed handle may still be processed
+		 * by the server. They are recorded as orphans by their bulk-buffer
+		 * offset and given back once acknowledged. The number of readahead
+		 * packets in flight is limited, which bounds the number of orphans.
+		 */
+		struct Readahead_budget
+		{
+			enum { MAX_PACKETS = 64 };
+
+			file_size avail;
+
+			unsigned packets = 0;
+
+			struct Orphan
+			{
+				Genode::off_t offset;
+				file_size     length;
+				bool          used;
+			};
+
+			Orphan orphans[MAX_PACKETS] { };
+
+			Readahead_budget(file_size avail) : avail(avail) { }
+
+			bool take(file_size n)
+			{
+				if (n > avail || packets == MAX_PACKETS)
+					return false;
+
+				avail -= n;
+				packets++;
+				return true;
+			}
+
+			void give(file_size n)
+			{
+				avail += n;
+				packets--;
+			}
+
+			/**
+			 * Record readahead packet that outlives its handle
+			 */
+			void orphan(Genode::off_t offset, file_size n)
+			{
+				for (Orphan &o : orphans)
+					if (!o.used) {
+						o = Orphan { offset, n, true };
+						return;
+					}
+			}
+
+			/**
+			 * Give back the budget of an acknowledged orphan, if any
+			 */
+			void release_orphan(Genode::off_t offset)
+			{
+				for (Orphan &o : orphans)
+					if (o.used && o.offset == offset) {
+						o.used = false;
+						give(o.length);
+						return;
+					}
+			}
+		};
+
 		::File_system::Connection _fs;
 
+		/*
+		 * Readahead packets of all handles together occupy at most half of
+		 * the bulk buffer, leaving the other half to the requested reads
+		 */
+		Readahead_budget _readahead_budget { _fs.tx()->bulk_buffer_size() / 2 };
+
 		typedef Genode::Id_space<::File_system::Node> Handle_space;
 
 		Handle_space _handle_space { };
@@ -170,6 +248,24 @@ class Vfs::Fs_file_system : public File_system
 				return true;
 			}
 
+			/**
+			 * Called on the acknowledgement of a read packet
+			 *
+			 * \return true if the packet is not used by the handle and
+			 *         must be released by the caller
+			 */
+			virtual bool read_acked(::File_system::Packet_descriptor const &packet)
+			{
+				queued_read_packet = packet;
+				queued_read_state  = Handle_state::Queued_state::ACK;
+				return false;
+			}
+
+			/**
+			 * Discard data read in advance, e.g., after the file was modified
+			 */
+			virtual void invalidate_reads() { }
+
 			virtual Read_result complete_read(char *,
 			                                  file_size /* in count */,
 			                                  file_size & /* out count */)
@@ -233,19 +329,288 @@ class Vfs::Fs_file_system : public File_system
 			}
 		};
 
+		/*
+		 * A read of a file is split into several packets that are processed
+		 * by the server concurrently. For sequential access, the packets
+		 * for the subsequent file range (readahead window) are submitted in
+		 * advance. The data of acknowledged packets is kept until it is
+		 * consumed by 'complete_read'. The readahead packets are accounted
+		 * to the session-wide readahead budget.
+		 */
 		struct Fs_vfs_file_handle : Fs_vfs_handle
 		{
-			using Fs_vfs_handle::Fs_vfs_handle;
+			enum { MAX_READ_PACKETS = 8 };
+
+			struct Read_packet
+			{
+				enum class State { FREE, QUEUED, ACK };
+				State state = State::FREE;
+
+				::File_system::Packet_descriptor packet { };
+
+				file_size offset = 0;
+				file_size length = 0;
+
+				/* packet is released as soon as it gets acknowledged */
+				bool stale = false;
+
+				/* packet is accounted to the readahead budget */
+				bool readahead = false;
+
+				file_size end() const { return offset + length; }
+
+				bool used() const { return state != State::FREE && !stale; }
+
+				bool contains(file_size pos) const {
+					return used() && pos >= offset && pos < end(); }
+
+				/* acknowledged packet with less data than requested */
+				bool eof() const {
+					return state == State::ACK && packet.length() < length; }
+			};
+
+			Read_packet _read_packets[MAX_READ_PACKETS];
+
+			file_size const _readahead;
+
+			Readahead_budget &_readahead_budget;
+
+			/* end of the previous read, used to detect sequential access */
+			file_size _sequential_end = 0;
+
+			Fs_vfs_file_handle(File_system &fs, Allocator &alloc,
+			                   int status_flags, Handle_space &space,
+			                   ::File_system::Node_handle node_handle,
+			                   ::File_system::Connection &fs_connection,
+			                   Io_response_handler &io_handler,
+			                   file_size readahead,
+			                   Readahead_budget &readahead_budget)
+			:
+				Fs_vfs_handle(fs, alloc, status_flags, space, node_handle,
+				              fs_connection, io_handler),
+				_readahead(readahead), _readahead_budget(readahead_budget)
+			{ }
+
+			~Fs_vfs_file_handle()
+			{
+				invalidate_reads();
+
+				/* hand the budget of pending readahead over to the session */
+				for (Read_packet &p : _read_packets)
+					if (p.state == Read_packet::State::QUEUED && p.readahead)
+						_readahead_budget.orphan(p.packet.offset(), p.length);
+			}
+
+			void _free(Read_packet &p)
+			{
+				if (p.readahead)
+					_readahead_budget.give(p.length);
+
+				p = Read_packet();
+			}
+
+			void _release(Read_packet &p)
+			{
+				if (p.state == Read_packet::State::ACK) {
+					_fs.tx()->release_packet(p.packet);
+					_free(p);
+					return;
+				}
+
+				/* packet is still processed by the server */
+				if (p.state == Read_packet::State::QUEUED)
+					p.stale = true;
+			}
+
+			Read_packet *_lookup(file_size pos)
+			{
+				for (Read_packet &p : _read_packets)
+					if (p.contains(pos))
+						return &p;
+				return nullptr;
+			}
+
+			bool _submit_read(file_size pos, file_size len, bool readahead)
+			{
+				Read_packet *slot = nullptr;
+				for (Read_packet &p : _read_packets)
+					if (p.state == Read_packet::State::FREE) {
+						slot = &p;
+						break;
+					}
+
+				::File_system::Session::Tx::Source &source = *_fs.tx();
+
+				if (!slot || !source.ready_to_submit())
+					return false;
+
+				if (readahead && !_readahead_budget.take(len))
+					return false;
+
+				::File_system::Packet_descriptor p;
+				try {
+					p = source.alloc_packet(len);
+				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+					if (readahead)
+						_readahead_budget.give(len);
+					return false;
+				}
+
+				::File_system::Packet_descriptor const
+					packet(p, file_handle(),
+					       ::File_system::Packet_descriptor::READ, len, pos);
+
+				slot->state  = Read_packet::State::QUEUED;
+				slot->packet = packet;
+				slot->offset    = pos;
+				slot->length    = len;
+				slot->stale     = false;
+				slot->readahead = readahead;
+
+				source.submit_packet(packet);
+				return true;
+			}
 
 			bool queue_read(file_size count) override
 			{
-				return _queue_read(count, seek());
+				if (count == 0)
+					return true;
+
+				file_size const start = seek();
+				file_size const end   = start + count;
+
+				bool const sequential = (start == _sequential_end);
+				file_size const window_end = end + (sequential ? _readahead : 0);
+
+				/* drop data outside the window, e.g., after a seek */
+				for (Read_packet &p : _read_packets)
+					if (p.used() && (p.end() <= start || p.offset >= window_end))
+						_release(p);
+
+				file_size const chunk_size =
+					_fs.tx()->bulk_buffer_size() / (2*MAX_READ_PACKETS);
+
+				bool readahead_released = false;
+
+				/* submit packets for the parts of the window not yet requested */
+				for (file_size pos = start; pos < window_end; ) {
+
+					if (Read_packet *p = _lookup(pos)) {
+						if (p->eof())
+							break;
+						pos = p->end();
+						continue;
+					}
+
+					file_size const len      = min(chunk_size, window_end - pos);
+					bool      const demanded = pos < end;
+
+					if (_submit_read(pos, len, !demanded)) {
+						pos += len;
+						continue;
+					}
+
+					/*
+					 * Make room for the requested range by dropping the
+					 * readahead of this handle
+					 */
+					if (!demanded || readahead_released)
+						break;
+
+					for (Read_packet &p : _read_packets)
+						if (p.used() && p.offset >= end)
+							_release(p);
+
+					readahead_released = true;
+				}
+
+				/* if the start of the range could not be requested, suggest retry */
+				return _lookup(start) != nullptr;
 			}
 
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				if (count == 0)
+					return READ_OK;
+
+				file_size const start = seek();
+
+				Read_packet const *first = _lookup(start);
+				if (!first)
+					return READ_ERR_IO;
+
+				if (first->state != Read_packet::State::ACK)
+					return READ_QUEUED;
+
+				::File_system::Session::Tx::Source &source = *_fs.tx();
+
+				/* copy data of consecutive acknowledged packets */
+				file_size copied = 0;
+				while (copied < count) {
+
+					file_size const pos = start + copied;
+
+					Read_packet *p = _lookup(pos);
+					if (!p || p->state != Read_packet::State::ACK)
+						break;
+
+					file_size const data_end = p->offset + p->packet.length();
+					file_size const n = pos < data_end
+					                  ? min(data_end - pos, count - copied) : 0;
+
+					memcpy(dst + copied,
+					       source.packet_content(p->packet) + (pos - p->offset), n);
+
+					copied += n;
+
+					bool const eof = p->eof();
+
+					if (pos + n >= data_end)
+						_release(*p);
+
+					if (eof)
+						break;
+				}
+
+				out_count       = copied;
+				_sequential_end = start + copied;
+
+				/*
+				 * Notify anyone who might have failed on
+				 * 'alloc_packet()' or 'submit_packet()'
+				 */
+				_io_handler.handle_io_response(nullptr);
+
+				return READ_OK;
+			}
+
+			bool read_acked(::File_system::Packet_descriptor const &packet) override
+			{
+				for (Read_packet &p : _read_packets) {
+
+					if (p.state != Read_packet::State::QUEUED
+					 || p.packet.offset() != packet.offset())
+						continue;
+
+					if (p.stale) {
+						_free(p);
+						return true;
+					}
+
+					p.state  = Read_packet::State::ACK;
+					p.packet = packet;
+					return false;
+				}
+				return true;
+			}
+
+			void invalidate_reads() override
+			{
+				for (Read_packet &p : _read_packets)
+					_release(p);
+
+				_sequential_end = 0;
 			}
 		};
 
@@ -480,30 +845,43 @@ class Vfs::Fs_file_system : public File_system
 			::File_system::Session::Tx::Source &source = *_fs.tx();
 			using ::File_system::Packet_descriptor;
 
-			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			count = min(max_packet_size, count);
+			/*
+			 * Split large writes into several packets, which lets the
+			 * server process one packet while the next one is copied.
+			 */
+			file_size const max_packet_size = source.bulk_buffer_size() / 4;
 
-			if (!source.ready_to_submit())
-				throw Insufficient_buffer();
+			handle.invalidate_reads();
 
-			try {
-				Packet_descriptor packet_in(source.alloc_packet(count),
-				                            handle.file_handle(),
-				                            Packet_descriptor::WRITE,
-				                            count,
-				                            seek_offset);
+			file_size written = 0;
+			while (written < count && source.ready_to_submit()) {
 
-				memcpy(source.packet_content(packet_in), buf, count);
+				file_size const len = min(max_packet_size, count - written);
 
-				/* pass packet to server side */
-				source.submit_packet(packet_in);
-			} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
-				throw Insufficient_buffer();
-			} catch (...) {
-				Genode::error("unhandled exception");
-				return 0;
+				try {
+					Packet_descriptor packet_in(source.alloc_packet(len),
+					                            handle.file_handle(),
+					                            Packet_descriptor::WRITE,
+					                            len,
+					                            seek_offset + written);
+
+					memcpy(source.packet_content(packet_in), buf + written, len);
+
+					/* pass packet to server side */
+					source.submit_packet(packet_in);
+				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+					break;
+				} catch (...) {
+					Genode::error("unhandled exception");
+					break;
+				}
+				written += len;
 			}
-			return count;
+
+			if (written == 0)
+				throw Insufficient_buffer();
+
+			return written;
 		}
 
 		void _handle_ack()
@@ -517,6 +895,8 @@ class Vfs::Fs_file_system : public File_system
 
 				Handle_space::Id const id(packet.handle());
 
+				bool release = (packet.operation() == Packet_descriptor::WRITE);
+
 				try {
 					_handle_space.apply<Fs_vfs_handle>(id, [&] (Fs_vfs_handle &handle)
 					{
@@ -527,8 +907,7 @@ class Vfs::Fs_file_system : public File_system
 							break;
 
 						case Packet_descriptor::READ:
-							handle.queued_read_packet = packet;
-							handle.queued_read_state  = Handle_state::Queued_state::ACK;
+							release = handle.read_acked(packet);
 							_post_signal_hook.arm(handle.context);
 							break;
 
@@ -553,9 +932,23 @@ class Vfs::Fs_file_system : public File_system
 						}
 					});
 				} catch (Handle_space::Unknown_id) {
-					Genode::warning("ack for unknown VFS handle"); }
 
-				if (packet.operation() == Packet_descriptor::WRITE) {
+					/* read packets may outlive the handle that submitted them */
+					if (packet.operation() == Packet_descriptor::READ)
+						release = true;
+					else
+						Genode::warning("ack for unknown VFS handle");
+				}
+
+				if (release) {
+
+					/*
+					 * The acknowledgement of a closed handle's readahead may
+					 * arrive at a new handle with the same node handle
+					 */
+					if (packet.operation() == Packet_descriptor::READ)
+						_readahead_budget.release_orphan(packet.offset());
+
 					Lock::Guard guard(_lock);
 					source.release_packet(packet);
 				}
@@ -577,10 +970,12 @@ class Vfs::Fs_file_system : public File_system
 			_io_handler(io_handler),
 			_label(config.attribute_value("label", Label_string())),
 			_root( config.attribute_value("root",  Root_string())),
+			_readahead(config.attribute_value("readahead", Genode::Number_of_bytes(0))),
 			_fs(env, _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    ::File_system::DEFAULT_TX_BUF_SIZE)
+			    config.attribute_value("buffer_size",
+			                           Genode::Number_of_bytes(::File_system::DEFAULT_TX_BUF_SIZE)))
 		{
 			_fs.sigh_ack_avail(_ack_handler);
 		}
@@ -766,7 +1161,8 @@ class Vfs::Fs_file_system : public File_system
 
 				*out_handle = new (alloc)
 					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space,
-					                   file, _fs, _io_handler);
+					                   file, _fs, _io_handler, _readahead,
+					                   _readahead_budget);
 			}
 			catch (::File_system::Lookup_failed)       { return OPEN_ERR_UNACCESSIBLE;  }
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM;       }
@@ -946,7 +1342,12 @@ class Vfs::Fs_file_system : public File_system
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			{
+				Lock::Guard guard(_lock);
+				handle->invalidate_reads();
+			}
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
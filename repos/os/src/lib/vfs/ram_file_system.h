@@ -14,7 +14,7 @@
 #ifndef _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
-#include <ram_fs/chunk.h>
+#include <ram_fs/extent.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
 #include <util/avl_tree.h>
@@ -47,6 +47,18 @@ namespace Vfs_ram {
 		return start;
 	}
 
+	/**
+	 * Return FNV-1a hash of the first 'len' characters of 'name'
+	 */
+	static inline unsigned name_hash(char const *name, size_t len)
+	{
+		unsigned hash = 2166136261u;
+
+		for (size_t i = 0; i < len; i++)
+			hash = (hash ^ (unsigned char)name[i])*16777619u;
+
+		return hash;
+	}
 }
 
 namespace Vfs { class Ram_file_system; }
@@ -63,6 +75,15 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Lock
 		char _name[MAX_NAME_LEN];
 		int  _open_handles = 0;
 
+		/*
+		 * Links of the sorted entry sequence and of the hash index of the
+		 * parent directory
+		 */
+		Node     *_prev      = nullptr;
+		Node     *_next      = nullptr;
+		Node     *_hash_next = nullptr;
+		unsigned  _hash      = 0;
+
 		/**
 		 * Generate unique inode number
 		 */
@@ -137,36 +158,21 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Lock
 		bool higher(Node *c) { return (strcmp(c->_name, _name) > 0); }
 
 		/**
-		 * Find index N by walking down the tree N times,
-		 * not the most efficient way to do this.
+		 * Return node with the highest name below 'name' within the subtree
 		 */
-		Node *index(file_offset &i)
+		Node *predecessor(char const *name)
 		{
-			if (i-- == 0)
-				return this;
-
-			Node *n;
-
-			n = child(LEFT);
-			if (n)
-				n = n->index(i);
-
-			if (n) return n;
-
-			n = child(RIGHT);
-			if (n)
-				n = n->index(i);
+			Node *result = nullptr;
 
-			return n;
-		}
-
-		Node *sibling(const char *name)
-		{
-			if (strcmp(name, _name) == 0) return this;
-
-			Node *c =
-				Avl_node<Node>::child(strcmp(name, _name) > 0);
-			return c ? c->sibling(name) : nullptr;
+			for (Node *n = this; n; ) {
+				if (strcmp(n->_name, name) < 0) {
+					result = n;
+					n = n->child(RIGHT);
+				} else {
+					n = n->child(LEFT);
+				}
+			}
+			return result;
 		}
 
 		struct Guard
@@ -184,49 +190,26 @@ class Vfs_ram::File : public Vfs_ram::Node
 {
 	private:
 
-		typedef ::File_system::Chunk<4096>      Chunk_level_3;
-		typedef ::File_system::Chunk_index<128, Chunk_level_3> Chunk_level_2;
-		typedef ::File_system::Chunk_index<64,  Chunk_level_2> Chunk_level_1;
-		typedef ::File_system::Chunk_index<64,  Chunk_level_1> Chunk_level_0;
+		::File_system::Extent_store _extents;
 
-		Chunk_level_0 _chunk;
-		file_size     _length = 0;
+		file_size _length = 0;
 
 	public:
 
 		File(char const *name, Allocator &alloc)
-		: Node(name), _chunk(alloc, 0) { }
+		: Node(name), _extents(alloc) { }
 
 		size_t read(char *dst, size_t len, file_size seek_offset) override
 		{
-			file_size const chunk_used_size = _chunk.used_size();
-
 			if (seek_offset >= _length)
 				return 0;
 
-			/*
-			 * Constrain read transaction to available chunk data
-			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
-			 */
+			/* constrain read transaction to the file length */
 			if (seek_offset + len >= _length)
 				len = _length - seek_offset;
 
-			file_size read_len = len;
-
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
-				else
-					read_len = 0;
-			}
-
-			_chunk.read(dst, read_len, seek_offset);
-
-			/* add zero padding if needed */
-			if (read_len < len)
-				memset(dst + read_len, 0, len - read_len);
+			/* holes and the range beyond the written data read as zero */
+			_extents.read(dst, len, seek_offset);
 
 			return len;
 		}
@@ -243,18 +226,15 @@ class Vfs_ram::File : public Vfs_ram::Node
 		size_t write(char const *src, size_t len, file_size seek_offset) override
 		{
 			if (seek_offset == (file_size)(~0))
-				seek_offset = _chunk.used_size();
-
-			if (seek_offset + len >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - (seek_offset + len);
+				seek_offset = _length;
 
-			try { _chunk.write(src, len, (size_t)seek_offset); }
+			try { _extents.write(src, len, seek_offset); }
 			catch (Out_of_memory) { return 0; }
 
 			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
+			 * Keep track of file length. We cannot use 'used_size()' of the
+			 * extents as file length because the file may have been
+			 * extended by 'truncate' without writing.
 			 */
 			_length = max(_length, seek_offset + len);
 
@@ -265,8 +245,7 @@ class Vfs_ram::File : public Vfs_ram::Node
 
 		void truncate(file_size size) override
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			_extents.truncate(size);
 
 			_length = size;
 		}
@@ -331,18 +310,105 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 {
 	private:
 
-		Avl_tree<Node>  _entries { };
-		file_size       _count = 0;
+		enum { INITIAL_BUCKETS = 16 };
+
+		Allocator &_alloc;
+
+		/* entries ordered by name */
+		Avl_tree<Node> _entries { };
+
+		/* entries in the same order, linked for reading the directory */
+		Node *_first = nullptr;
+
+		/* hash index for looking up entries by name */
+		Node  *_initial_buckets[INITIAL_BUCKETS] { };
+		Node **_buckets     = _initial_buckets;
+		size_t _num_buckets = INITIAL_BUCKETS;
+
+		/* entry returned by the most recent directory read */
+		Node      *_cursor       = nullptr;
+		file_size  _cursor_index = 0;
+
+		file_size _count = 0;
+
+		Node *&_bucket(unsigned hash) { return _buckets[hash & (_num_buckets - 1)]; }
+
+		/**
+		 * Double the number of hash buckets
+		 *
+		 * If the allocation fails, the directory keeps working with longer
+		 * hash chains.
+		 */
+		void _grow_buckets()
+		{
+			size_t const num_buckets = 2*_num_buckets;
+
+			Node **buckets = nullptr;
+			try {
+				if (!_alloc.alloc(num_buckets*sizeof(Node *), (void **)&buckets))
+					return;
+			} catch (Out_of_memory) { return; }
+
+			for (size_t i = 0; i < num_buckets; i++)
+				buckets[i] = nullptr;
+
+			for (size_t i = 0; i < _num_buckets; i++) {
+				while (Node *node = _buckets[i]) {
+					_buckets[i] = node->_hash_next;
+
+					Node *&bucket = buckets[node->_hash & (num_buckets - 1)];
+					node->_hash_next = bucket;
+					bucket = node;
+				}
+			}
+
+			if (_buckets != _initial_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(Node *));
+
+			_buckets     = buckets;
+			_num_buckets = num_buckets;
+		}
+
+		/**
+		 * Return entry at 'index' of the sorted sequence
+		 *
+		 * Sequential reads continue from the entry of the previous read.
+		 */
+		Node *_entry(file_size index)
+		{
+			Node     *node = _first;
+			file_size i    = 0;
+
+			if (_cursor && _cursor_index <= index) {
+				node = _cursor;
+				i    = _cursor_index;
+			}
+
+			for (; node && i < index; i++)
+				node = node->_next;
+
+			if (node) {
+				_cursor       = node;
+				_cursor_index = index;
+			}
+			return node;
+		}
 
 	public:
 
-		Directory(char const *name)
-		: Node(name) { }
+		Directory(char const *name, Allocator &alloc)
+		: Node(name), _alloc(alloc) { }
+
+		~Directory()
+		{
+			if (_buckets != _initial_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(Node *));
+		}
 
 		void empty(Allocator &alloc)
 		{
-			while (Node *node = _entries.first()) {
-				_entries.remove(node);
+			while (Node *node = _first) {
+				release(node);
 				if (File *file = dynamic_cast<File*>(node)) {
 					if (file->close_but_keep())
 						continue;
@@ -356,18 +422,77 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 		void adopt(Node *node)
 		{
 			_entries.insert(node);
-			++_count;
+
+			/* link node into the sorted sequence behind its predecessor */
+			Node *prev = _entries.first()->predecessor(node->_name);
+
+			node->_prev = prev;
+			node->_next = prev ? prev->_next : _first;
+
+			if (node->_next) node->_next->_prev = node;
+			if (prev) prev->_next = node;
+			else      _first      = node;
+
+			node->_hash = name_hash(node->_name, strlen(node->_name));
+
+			Node *&bucket = _bucket(node->_hash);
+			node->_hash_next = bucket;
+			bucket = node;
+
+			/* keep the cursor pointing to the same entry */
+			if (_cursor && strcmp(node->_name, _cursor->_name) < 0)
+				_cursor_index++;
+
+			if (++_count > 2*_num_buckets)
+				_grow_buckets();
 		}
 
-		Node *child(char const *name)
+		/**
+		 * Look up entry by the first 'len' characters of 'name'
+		 */
+		Node *child(char const *name, size_t len)
 		{
-			Node *node = _entries.first();
-			return node ? node->sibling(name) : nullptr;
+			unsigned const hash = name_hash(name, len);
+
+			for (Node *node = _bucket(hash); node; node = node->_hash_next)
+				if (node->_hash == hash && strcmp(node->_name, name, len) == 0
+				 && node->_name[len] == 0)
+					return node;
+
+			return nullptr;
 		}
 
+		Node *child(char const *name) { return child(name, strlen(name)); }
+
 		void release(Node *node)
 		{
+			/*
+			 * Keep the cursor valid without restarting the next directory
+			 * read from the first entry. If the cursor refers to the
+			 * released entry, it steps back to the predecessor.
+			 */
+			if (node == _cursor) {
+				_cursor = node->_prev;
+				_cursor_index--;
+			} else if (_cursor && strcmp(node->_name, _cursor->_name) < 0) {
+				_cursor_index--;
+			}
+
 			_entries.remove(node);
+
+			if (node->_next) node->_next->_prev = node->_prev;
+			if (node->_prev) node->_prev->_next = node->_next;
+			else             _first             = node->_next;
+
+			for (Node **n = &_bucket(node->_hash); *n; n = &(*n)->_hash_next) {
+				if (*n == node) {
+					*n = node->_hash_next;
+					break;
+				}
+			}
+
+			node->_prev = node->_next = node->_hash_next = nullptr;
+
 			--_count;
 		}
 
@@ -383,14 +508,13 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 			if (count < sizeof(Dirent))
 				return Vfs::File_io_service::READ_ERR_INVALID;
 
-			file_offset index = seek_offset / sizeof(Dirent);
+			file_size const index = seek_offset / sizeof(Dirent);
 
 			Dirent *dirent = (Dirent*)dst;
 			*dirent = Dirent();
 			out_count = sizeof(Dirent);
 
-			Node *node = _entries.first();
-			if (node) node = node->index(index);
+			Node *node = _entry(index);
 			if (!node) {
 				dirent->type = Directory_service::DIRENT_TYPE_END;
 				return Vfs::File_io_service::READ_OK;
@@ -442,7 +566,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 		Genode::Env        &_env;
 		Genode::Allocator  &_alloc;
-		Vfs_ram::Directory  _root = { "" };
+		Vfs_ram::Directory  _root { "", _alloc };
 
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
@@ -451,31 +575,25 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			if (*path ==  '/') ++path;
 			if (*path == '\0') return &_root;
 
-			char buf[Vfs::MAX_PATH_LEN];
-			strncpy(buf, path, Vfs::MAX_PATH_LEN);
 			Directory *dir = &_root;
 
-			char *name = &buf[0];
-			for (size_t i = 0; i < MAX_PATH_LEN; ++i) {
-				if (buf[i] == '/') {
-					buf[i] = '\0';
+			/* walk the path components in place */
+			for (;;) {
+				size_t len = 0;
+				while (path[len] && path[len] != '/')
+					++len;
 
-					Node *node = dir->child(name);
-					if (!node) return nullptr;
+				if (path[len] == '\0')
+					return return_parent ? dir : dir->child(path, len);
 
-					dir = dynamic_cast<Directory *>(node);
-					if (!dir) return nullptr;
+				Node *node = dir->child(path, len);
+				if (!node) return nullptr;
 
-					/* set the current name aside */
-					name = &buf[i+1];
-				} else if (buf[i] == '\0') {
-					if (return_parent)
-						return dir;
-					else
-						return dir->child(name);
-				}
+				dir = dynamic_cast<Directory *>(node);
+				if (!dir) return nullptr;
+
+				path += len + 1;
 			}
-			return nullptr;
 		}
 
 		Vfs_ram::Directory *lookup_parent(char const *path)
@@ -600,7 +718,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 					return OPENDIR_ERR_NODE_ALREADY_EXISTS;
 
 				try {
-					dir = new (_alloc) Directory(name);
+					dir = new (_alloc) Directory(name, _alloc);
 				} catch (Out_of_memory) { return OPENDIR_ERR_NO_SPACE; }
 
 				parent->adopt(dir);
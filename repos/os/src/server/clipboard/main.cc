@@ -59,11 +59,13 @@ struct Rom::Registry : Rom::Registry_for_reader, Rom::Registry_for_writer
 	/**
 	 * Constructor
 	 */
-	Registry(Genode::Ram_session &ram, Genode::Region_map &rm,
+	Registry(Genode::Allocator &alloc,
+	         Genode::Ram_session &ram, Genode::Region_map &rm,
+	         View_factory &views,
 	         Module::Read_policy  const &read_policy,
 	         Module::Write_policy const &write_policy)
 	:
-		module(ram, rm, "clipboard", read_policy, write_policy)
+		module(alloc, ram, rm, views, "clipboard", read_policy, write_policy)
 	{ }
 };
 
@@ -199,7 +201,10 @@ struct Clipboard::Main : Rom::Module::Read_policy, Rom::Module::Write_policy
 		return false;
 	}
 
-	Rom::Registry _rom_registry { _env.ram(), _env.rm(), *this, *this };
+	Rom::View_factory _views { _env };
+
+	Rom::Registry _rom_registry { _sliced_heap, _env.ram(), _env.rm(), _views,
+	                              *this, *this };
 
 	Report::Root report_root = { _env, _sliced_heap, _rom_registry, verbose };
 	Rom   ::Root    rom_root = { _env, _sliced_heap, _rom_registry };
@@ -17,6 +17,8 @@
 #include <file_system/util.h>
 #include <os/path.h>
 #include <base/attached_ram_dataspace.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 #include <root/component.h>
 #include <base/component.h>
 #include <base/session_label.h>
@@ -33,29 +35,198 @@ namespace Fs_rom {
 
 	struct Packet_handler;
 
+	struct Content;
+	class Content_cache;
+	class File;
 	class Rom_session_component;
 	class Rom_root;
 
+	typedef List<Content>               Contents;
+	typedef List<File>                  Files;
 	typedef List<Rom_session_component> Sessions;
 
 	typedef File_system::Session_client::Tx::Source Tx_source;
+
+	/*
+	 * Version number used to track the need for ROM update notifications
+	 */
+	struct Version { unsigned value; };
 }
 
 
 /**
- * A 'Rom_session_component' exports a single file of the file system
+ * Immutable file content, shared by all ROM sessions that obtained it
  */
-class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
-                                      private Sessions::Element
+struct Fs_rom::Content : Contents::Element
+{
+	Attached_ram_dataspace ds;
+
+	size_t size;
+
+	unsigned long hash = 0;
+
+	/* number of files and sessions referring to the content */
+	unsigned refs = 0;
+
+	/*
+	 * Managed dataspace with 'ds' attached read-only, handed out to the
+	 * clients, created when the content is published
+	 */
+	Constructible<Region_map_client> view { };
+
+	Content(Ram_session &ram, Region_map &rm, size_t size)
+	: ds(ram, rm, size), size(size) { }
+
+	bool equals(Content const &other) const
+	{
+		return size == other.size && hash == other.hash
+		    && memcmp(ds.local_addr<char const>(),
+		              other.ds.local_addr<char const>(), size) == 0;
+	}
+
+	Dataspace_capability rom_ds() { return view->dataspace(); }
+};
+
+
+/**
+ * Cache of file contents, indexed by the content
+ *
+ * Files with equal content, or successive versions of a file with equal
+ * content, refer to the same dataspace. Clients obtain the dataspace only
+ * through a read-only managed dataspace. A content is freed once it is no
+ * longer referenced by a file or a ROM session.
+ */
+class Fs_rom::Content_cache : Noncopyable
 {
 	private:
 
-		friend class List<Rom_session_component>;
+		Allocator   &_alloc;
+		Ram_session &_ram;
+		Region_map  &_rm;
+
+		Rm_connection _rm_connection;
+
+		Contents _contents { };
+
+		static unsigned long _hash(char const *data, size_t len)
+		{
+			/* FNV-1a */
+			unsigned long h = 2166136261UL;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)data[i]) * 16777619UL;
+			return h;
+		}
+
+		/**
+		 * Create read-only view of the content
+		 */
+		void _create_view(Content &content)
+		{
+			Capability<Region_map> rm;
+			for (;;) {
+				try { rm = _rm_connection.create(content.ds.size()); break; }
+				catch (Out_of_ram)  { _rm_connection.upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm_connection.upgrade_caps(2); }
+			}
+
+			content.view.construct(rm);
+
+			for (;;) {
+				try {
+					content.view->attach(content.ds.cap(), 0, 0, true,
+					                     (addr_t)0, false, false);
+					return;
+				}
+				catch (Out_of_ram)  { _rm_connection.upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm_connection.upgrade_caps(2); }
+			}
+		}
+
+	public:
+
+		Content_cache(Env &env, Allocator &alloc)
+		:
+			_alloc(alloc), _ram(env.ram()), _rm(env.rm()), _rm_connection(env)
+		{ }
+
+		/**
+		 * Allocate backing store for a new content
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Content &alloc(size_t size) {
+			return *new (_alloc) Content(_ram, _rm, size); }
+
+		/**
+		 * Discard content that is not or no longer cached
+		 */
+		void discard(Content &content)
+		{
+			if (content.view.constructed())
+				_rm_connection.destroy(content.view->rpc_cap());
+
+			destroy(_alloc, &content);
+		}
+
+		/**
+		 * Enter completely read content into the cache
+		 *
+		 * If the content cannot be published, it is discarded.
+		 *
+		 * \return  cached content, which is not necessarily 'content'
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Content &publish(Content &content)
+		{
+			content.hash = _hash(content.ds.local_addr<char const>(), content.size);
+
+			for (Content *c = _contents.first(); c; c = c->next())
+				if (c->equals(content)) {
+					discard(content);
+					return *c;
+				}
+
+			try { _create_view(content); }
+			catch (...) {
+				discard(content);
+				throw;
+			}
+
+			_contents.insert(&content);
+			return content;
+		}
+
+		void acquire(Content &content) { content.refs++; }
+
+		void release(Content &content)
+		{
+			if (--content.refs)
+				return;
+
+			_contents.remove(&content);
+			discard(content);
+		}
+};
+
+
+/**
+ * Watched file of the file system, shared by the ROM sessions of the file
+ */
+class Fs_rom::File : private Files::Element
+{
+	private:
+
+		friend class List<File>;
 
 		Env &_env;
 
 		File_system::Session &_fs;
 
+		Content_cache &_cache;
+
 		enum { PATH_MAX_LEN = 512 };
 		typedef Genode::Path<PATH_MAX_LEN> Path;
 
@@ -69,16 +240,6 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
 		 */
 		Constructible<File_system::File_handle> _file_handle { };
 
-		/**
-		 * Size of current version of the file
-		 */
-		File_system::file_size_t _file_size = 0;
-
-		/**
-		 * Read offset of the file
-		 */
-		File_system::seek_off_t _file_seek = 0;
-
 		/**
 		 * Handle of currently watched compound directory
 		 *
@@ -88,26 +249,38 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
 		Constructible<File_system::Dir_handle> _compound_dir_handle { };
 
 		/**
-		 * Dataspace exposed as ROM module to the client
+		 * Current content, or nullptr if the file is empty or missing
 		 */
-		Attached_ram_dataspace _file_ds;
+		Content *_content = nullptr;
 
 		/**
-		 * Signal destination for ROM file changes
+		 * True if '_content' does not reflect the most current file content
 		 */
-		Signal_context_capability _sigh { };
+		bool _stale = true;
+
+		Version _version { 0 };
+
+		/**
+		 * ROM sessions referring to the file
+		 */
+		Sessions _sessions { };
 
 		/*
-		 * Exception
+		 * State of the read operation in progress
 		 */
-		struct Open_compound_dir_failed { };
+		enum { MAX_READS_IN_FLIGHT = 4 };
+
+		Content *_read_dst       = nullptr;
+		size_t   _read_size      = 0;
+		size_t   _read_submitted = 0;
+		size_t   _read_received  = 0;
+		unsigned _read_in_flight = 0;
+		bool     _read_failed    = false;
 
 		/*
-		 * Version number used to track the need for ROM update notifications
+		 * Exception
 		 */
-		struct Version { unsigned value; };
-		Version _curr_version       { 0 };
-		Version _handed_out_version { ~0U };
+		struct Open_compound_dir_failed { };
 
 		/**
 		 * Open compound directory of specified file
@@ -209,33 +382,87 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
 				warning("could not track compound dir, giving up"); }
 		}
 
+		void _replace_content(Content *content)
+		{
+			if (content)
+				_cache.acquire(*content);
+
+			if (_content)
+				_cache.release(*_content);
+
+			_content = content;
+		}
+
 		/**
-		 * Initialize '_file_ds' dataspace with file content
+		 * Read file content into 'dst'
+		 *
+		 * The read requests are pipelined such that multiple packets are in
+		 * flight at any time. The packet acknowledgements may arrive in any
+		 * order.
+		 *
+		 * \return  false if the file could not be read completely
 		 */
-		void _update_dataspace()
+		bool _read(Content &dst)
 		{
-			using namespace File_system;
+			using File_system::Packet_descriptor;
 
-			/*
-			 * On each repeated call of this function, the dataspace is
-			 * replaced with a new one that contains the most current file
-			 * content. The dataspace is re-allocated if the new version
-			 * of the file has become bigger.
-			 */
-			try {
-				File_handle const file_handle = _open_file(_fs, _file_path);
-				File_system::file_size_t const new_file_size =
-					_fs.status(file_handle).size;
-
-				if (_file_ds.size() && (new_file_size > _file_size)) {
-					/* mark as invalid */
-					_file_ds.realloc(&_env.ram(), 0);
-					_file_size = 0;
-					_file_seek = 0;
+			_read_dst       = &dst;
+			_read_size      = dst.size;
+			_read_submitted = 0;
+			_read_received  = 0;
+			_read_failed    = false;
+
+			Tx_source &source = *_fs.tx();
+
+			size_t const max_chunk_size =
+				max(source.bulk_buffer_size() / MAX_READS_IN_FLIGHT, (size_t)1);
+
+			while (!_read_failed && _read_received < _read_size) {
+
+				/* fill the packet stream with as many requests as possible */
+				while (_read_submitted < _read_size
+				    && _read_in_flight < MAX_READS_IN_FLIGHT
+				    && source.ready_to_submit()) {
+
+					size_t const chunk_size =
+						min(_read_size - _read_submitted, max_chunk_size);
+
+					Packet_descriptor packet;
+					try { packet = source.alloc_packet(chunk_size); }
+					catch (Tx_source::Packet_alloc_failed) { break; }
+
+					source.submit_packet(Packet_descriptor(packet, *_file_handle,
+					                                       Packet_descriptor::READ,
+					                                       chunk_size,
+					                                       _read_submitted));
+					_read_submitted += chunk_size;
+					_read_in_flight++;
 				}
-				_fs.close(file_handle);
-			} catch (Open_file_failed) { }
 
+				/*
+				 * Process the global signal handler until we got a response
+				 * for one of the read requests
+				 */
+				_env.ep().wait_and_dispatch_one_io_signal();
+			}
+
+			/* drain requests that are still in flight after an error */
+			while (_read_in_flight)
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			_read_dst = nullptr;
+
+			/* the file may have been truncated while reading */
+			dst.size = min(dst.size, _read_size);
+
+			return !_read_failed;
+		}
+
+		/**
+		 * Replace content by the most current file content
+		 */
+		void _update_content()
+		{
 			/* close and then re-open the file */
 			if (_file_handle.constructed()) {
 				_fs.close(*_file_handle);
@@ -260,85 +487,137 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
 				_fs.tx()->submit_packet(File_system::Packet_descriptor(
 					*_file_handle, File_system::Packet_descriptor::CONTENT_CHANGED));
 
+			_stale = false;
+
 			size_t const file_size = _file_handle.constructed()
 			                       ? _fs.status(*_file_handle).size : 0;
 
-			/* allocate new RAM dataspace according to file size */
-			if (file_size > 0) {
-				try {
-					_file_seek = 0;
-					_file_ds.realloc(&_env.ram(), file_size);
-					_file_size = file_size;
-				} catch (...) {
-					error("couldn't allocate memory for file, empty result");
-					return;
-				}
-			} else {
+			if (file_size == 0) {
+				_replace_content(nullptr);
 				_register_for_compound_dir_changes();
 				return;
 			}
 
-			/* omit read if file is empty */
-			if (_file_size == 0)
+			/* allocate new RAM dataspace according to file size */
+			Content *content = nullptr;
+			try { content = &_cache.alloc(file_size); }
+			catch (...) {
+				error("couldn't allocate memory for file, empty result");
+				_replace_content(nullptr);
 				return;
+			}
 
-			/* read content from file */
-			Tx_source &source = *_fs.tx();
-			while (_file_seek < _file_size) {
-				/* if we cannot submit then process acknowledgements */
-				if (source.ready_to_submit()) {
-					size_t chunk_size = min(_file_size - _file_seek,
-					                        source.bulk_buffer_size() / 2);
-					File_system::Packet_descriptor
-						packet(source.alloc_packet(chunk_size),
-						       *_file_handle,
-						       File_system::Packet_descriptor::READ,
-						       chunk_size,
-						       _file_seek);
-					source.submit_packet(packet);
-				}
+			if (!_read(*content)) {
+				error(_file_path, ": reading file failed, empty result");
+				_cache.discard(*content);
+				_replace_content(nullptr);
+				return;
+			}
 
-				/*
-				 * Process the global signal handler until we got a response
-				 * for the read request (indicated by a change of the seek
-				 * position).
-				 */
-				size_t const orig_file_seek = _file_seek;
-				while (_file_seek == orig_file_seek)
-					_env.ep().wait_and_dispatch_one_io_signal();
+			try { _replace_content(&_cache.publish(*content)); }
+			catch (...) {
+				error(_file_path, ": couldn't provide read-only view, empty result");
+				_replace_content(nullptr);
 			}
 		}
 
-		void _notify_client_about_new_version()
+	public:
+
+		using Files::Element::next;
+
+		File(Env &env, File_system::Session &fs, Content_cache &cache,
+		     char const *file_path)
+		:
+			_env(env), _fs(fs), _cache(cache), _file_path(file_path)
 		{
-			if (_sigh.valid() && _curr_version.value != _handed_out_version.value)
-				Signal_transmitter(_sigh).submit();
+			try {
+				_file_handle.construct(_open_file(_fs, _file_path));
+			} catch (Open_file_failed) { }
+
+			_register_for_compound_dir_changes();
+		}
+
+		~File()
+		{
+			_replace_content(nullptr);
+
+			if (_file_handle.constructed())
+				_fs.close(*_file_handle);
+
+			if (_compound_dir_handle.constructed())
+				_fs.close(*_compound_dir_handle);
 		}
 
+		bool has_path(char const *path) const { return _file_path.equals(path); }
+
+		Version version() const { return _version; }
+
+		void add(Rom_session_component &session)    { _sessions.insert(&session); }
+		void remove(Rom_session_component &session) { _sessions.remove(&session); }
+
+		bool in_use() const { return _sessions.first() != nullptr; }
+
+		/**
+		 * Return up-to-date content, or nullptr if the file is empty
+		 *
+		 * The file is read only if it changed since the last call.
+		 */
+		Content *content()
+		{
+			if (_stale)
+				_update_content();
+
+			return _content;
+		}
+
+		/**
+		 * If packet corresponds to this file then process and return true.
+		 *
+		 * Called from the signal handler.
+		 */
+		inline bool process_packet(File_system::Packet_descriptor const packet);
+};
+
+
+/**
+ * A 'Rom_session_component' exports a single file of the file system
+ */
+class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
+                                      private Sessions::Element
+{
+	private:
+
+		friend class List<Rom_session_component>;
+
+		File &_file;
+
+		Content_cache &_cache;
+
+		/**
+		 * Content exposed as ROM module to the client
+		 */
+		Content *_content = nullptr;
+
+		/**
+		 * Signal destination for ROM file changes
+		 */
+		Signal_context_capability _sigh { };
+
+		Version _handed_out_version { ~0U };
+
 	public:
 
 		/**
 		 * Constructor
 		 *
-		 * \param fs        file-system session to read the file from
-		 * \param filename  requested file name
-		 * \param sig_rec   signal receiver used to get notified about changes
-		 *                  within the compound directory (in the case when
-		 *                  the requested file could not be found at session-
-		 *                  creation time)
+		 * \param file   file exported by the session
+		 * \param cache  cache of the file contents
 		 */
-		Rom_session_component(Env &env,
-		                      File_system::Session &fs, const char *file_path)
+		Rom_session_component(File &file, Content_cache &cache)
 		:
-			_env(env), _fs(fs),
-			_file_path(file_path),
-			_file_ds(env.ram(), env.rm(), 0) /* realloc later */
+			_file(file), _cache(cache)
 		{
-			try {
-				_file_handle.construct(_open_file(_fs, _file_path));
-			} catch (Open_file_failed) { }
-
-			_register_for_compound_dir_changes();
+			_file.add(*this);
 		}
 
 		/**
@@ -346,96 +625,124 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>,
 		 */
 		~Rom_session_component()
 		{
-			/* close re-open the file */
-			if (_file_handle.constructed())
-				_fs.close(*_file_handle);
+			_file.remove(*this);
 
-			if (_compound_dir_handle.constructed())
-				_fs.close(*_compound_dir_handle);
+			if (_content)
+				_cache.release(*_content);
 		}
 
 		using Sessions::Element::next;
 
+		File &file() { return _file; }
+
 		/**
 		 * Return dataspace with up-to-date content of file
 		 */
 		Rom_dataspace_capability dataspace()
 		{
-			_update_dataspace();
-			Dataspace_capability ds = _file_ds.cap();
-			_handed_out_version = _curr_version;
+			Content * const content = _file.content();
+
+			/* keep the content alive as long as the client may use it */
+			if (content)
+				_cache.acquire(*content);
+
+			if (_content)
+				_cache.release(*_content);
+
+			_content = content;
+			_handed_out_version = _file.version();
+
+			if (!_content)
+				return Rom_dataspace_capability();
+
+			Dataspace_capability ds = _content->rom_ds();
 			return static_cap_cast<Rom_dataspace>(ds);
 		}
 
 		void sigh(Signal_context_capability sigh)
 		{
 			_sigh = sigh;
-			_notify_client_about_new_version();
+			notify_client_about_new_version();
 		}
 
-		/**
-		 * If packet corresponds to this session then process and return true.
-		 *
-		 * Called from the signal handler.
-		 */
-		bool process_packet(File_system::Packet_descriptor const packet)
+		void notify_client_about_new_version()
 		{
-			switch (packet.operation()) {
-
-			case File_system::Packet_descriptor::CONTENT_CHANGED:
+			if (_sigh.valid() && _file.version().value != _handed_out_version.value)
+				Signal_transmitter(_sigh).submit();
+		}
+};
 
-				_curr_version = Version { _curr_version.value + 1 };
 
-				if ((_file_handle.constructed() && (*_file_handle == packet.handle())) ||
-				    (_compound_dir_handle.constructed() && (*_compound_dir_handle == packet.handle())))
-				{
-					_notify_client_about_new_version();
-					return true;
-				}
-				return false;
+bool Fs_rom::File::process_packet(File_system::Packet_descriptor const packet)
+{
+	switch (packet.operation()) {
 
-			case File_system::Packet_descriptor::READ: {
+	case File_system::Packet_descriptor::CONTENT_CHANGED:
 
-				if (!(_file_handle.constructed() && (*_file_handle == packet.handle())))
-					return false;
+		if ((_file_handle.constructed() && (*_file_handle == packet.handle())) ||
+		    (_compound_dir_handle.constructed() && (*_compound_dir_handle == packet.handle())))
+		{
+			_version = Version { _version.value + 1 };
+			_stale   = true;
 
-				if (packet.position() > _file_seek || _file_seek >= _file_size) {
-					error("bad packet seek position");
-					_file_ds.realloc(&_env.ram(), 0);
-					return true;
-				}
+			for (Rom_session_component *s = _sessions.first(); s; s = s->next())
+				s->notify_client_about_new_version();
 
-				size_t const n = min(packet.length(), _file_size - _file_seek);
-				memcpy(_file_ds.local_addr<char>()+_file_seek,
-				       _fs.tx()->packet_content(packet), n);
-				_file_seek += n;
-				return true;
-			}
+			return true;
+		}
+		return false;
 
-			default:
+	case File_system::Packet_descriptor::READ: {
 
-				error("discarding strange packet acknowledgement");
-				return true;
-			}
+		if (!(_read_dst && _file_handle.constructed() && (*_file_handle == packet.handle())))
 			return false;
+
+		_read_in_flight--;
+
+		if (!packet.succeeded()) {
+			_read_failed = true;
+			return true;
 		}
-};
+
+		/* ignore data beyond the end of a file truncated while reading */
+		if (packet.position() >= _read_size)
+			return true;
+
+		size_t const n = min(packet.length(), _read_size - packet.position());
+		memcpy(_read_dst->ds.local_addr<char>() + packet.position(),
+		       _fs.tx()->packet_content(packet), n);
+		_read_received += n;
+
+		/* short read, the file got truncated */
+		if (n < packet.size()) {
+			_read_size     = packet.position() + n;
+			_read_received = min(_read_received, _read_size);
+		}
+		return true;
+	}
+
+	default:
+
+		error("discarding strange packet acknowledgement");
+		return true;
+	}
+	return false;
+}
 
 struct Fs_rom::Packet_handler : Io_signal_handler<Packet_handler>
 {
 	Tx_source &source;
 
-	/* list of open sessions */
-	Sessions sessions { };
+	/* list of watched files */
+	Files files { };
 
 	void handle_packets()
 	{
 		while (source.ack_avail()) {
 			File_system::Packet_descriptor pack = source.get_acked_packet();
-			for (Rom_session_component *session = sessions.first();
-			     session; session = session->next())
+			for (File *file = files.first(); file; file = file->next())
 			{
-				if (session->process_packet(pack))
+				if (file->process_packet(pack))
 					break;
 			}
 			source.release_packet(pack);
@@ -464,23 +771,51 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 
 		Packet_handler _packet_handler { _env.ep(), *_fs.tx() };
 
+		Content_cache _cache { _env, _heap };
+
+		/**
+		 * Return file object for the given path, shared by all sessions
+		 */
+		File &_file(char const *path)
+		{
+			for (File *f = _packet_handler.files.first(); f; f = f->next())
+				if (f->has_path(path))
+					return *f;
+
+			File *file = new (_heap) File(_env, _fs, _cache, path);
+			_packet_handler.files.insert(file);
+			return *file;
+		}
+
 		Rom_session_component *_create_session(const char *args) override
 		{
 			Session_label const label = label_from_args(args);
 			Session_label const module_name = label.last_element();
 
-			/* create new session for the requested file */
-			Rom_session_component *session = new (md_alloc())
-				Rom_session_component(_env, _fs, module_name.string());
+			File &file = _file(module_name.string());
 
-			_packet_handler.sessions.insert(session);
-			return session;
+			/* create new session for the requested file */
+			try {
+				return new (md_alloc()) Rom_session_component(file, _cache); }
+			catch (...) {
+				if (!file.in_use()) {
+					_packet_handler.files.remove(&file);
+					Genode::destroy(_heap, &file);
+				}
+				throw;
+			}
 		}
 
 		void _destroy_session(Rom_session_component *session) override
 		{
-			_packet_handler.sessions.remove(session);
+			File &file = session->file();
+
 			Genode::destroy(md_alloc(), session);
+
+			if (!file.in_use()) {
+				_packet_handler.files.remove(&file);
+				Genode::destroy(_heap, &file);
+			}
 		}
 
 	public:
@@ -18,6 +18,9 @@
 #include <base/log.h>
 #include <block/component.h>
 #include <block/driver.h>
+#include <base/semaphore.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 
 /* libc includes */
@@ -26,6 +29,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <stdio.h> /* perror */
+#include <stdlib.h> /* posix_memalign */
 
 
 static bool xml_attr_ok(Genode::Xml_node node, char const *attr)
@@ -38,7 +42,70 @@ class Lx_block_driver : public Block::Driver
 {
 	private:
 
-		Genode::Env &_env;
+		enum {
+			MAX_QUEUE_DEPTH = 256,
+			MAX_IO_THREADS  = 16,
+			DIRECT_ALIGN    = 4096,
+		};
+
+		/**
+		 * Host I/O operation corresponding to a block request
+		 */
+		struct Request
+		{
+			Block::Packet_descriptor packet  { };
+			char                    *buffer  = nullptr;
+			size_t                   count   = 0;
+			off_t                    offset  = 0;
+			bool                     write   = false;
+			bool                     success = false;
+		};
+
+		/**
+		 * Ring of requests, not synchronized
+		 */
+		struct Request_ring
+		{
+			Request  _requests[MAX_QUEUE_DEPTH];
+			unsigned _head = 0, _tail = 0, _count = 0;
+
+			bool empty() const { return _count == 0; }
+
+			void enqueue(Request const &request)
+			{
+				_requests[_head] = request;
+				_head = (_head + 1) % MAX_QUEUE_DEPTH;
+				_count++;
+			}
+
+			Request dequeue()
+			{
+				Request const request = _requests[_tail];
+				_tail = (_tail + 1) % MAX_QUEUE_DEPTH;
+				_count--;
+				return request;
+			}
+		};
+
+		/**
+		 * Thread performing the blocking host I/O
+		 */
+		struct Io_thread : Genode::Thread
+		{
+			Lx_block_driver &_driver;
+
+			Io_thread(Genode::Env &env, Lx_block_driver &driver)
+			:
+				Genode::Thread(env, "io", 8*1024*sizeof(long)), _driver(driver)
+			{
+				start();
+			}
+
+			void entry() override { _driver._process_requests(); }
+		};
+
+		Genode::Env       &_env;
+		Genode::Allocator &_alloc;
 
 		Block::sector_t            _block_count {   0 };
 		Genode::size_t             _block_size  { 512 };
@@ -46,12 +113,235 @@ class Lx_block_driver : public Block::Driver
 
 		int _fd { -1 };
 
+		bool const _direct;
+
+		unsigned const _queue_depth;
+
+		/*
+		 * Requests are passed from the entrypoint to the I/O threads via
+		 * '_pending' and back via '_completed'. Both rings are protected
+		 * by '_lock'.
+		 */
+		Genode::Lock      _lock      { };
+		Request_ring      _pending   { };
+		Request_ring      _completed { };
+		Genode::Semaphore _pending_sem { };
+
+		unsigned _in_flight    = 0;  /* submitted but not yet acknowledged */
+		unsigned _in_progress  = 0;  /* submitted but not yet completed */
+		unsigned _sync_waiters = 0;
+
+		Genode::Semaphore _idle_sem { };
+
+		Io_thread *_io_threads[MAX_IO_THREADS] { };
+		unsigned   _num_io_threads = 0;
+
+		Genode::Signal_handler<Lx_block_driver> _completion_handler {
+			_env.ep(), *this, &Lx_block_driver::_handle_completions };
+
+		/*
+		 * Queue-depth statistics
+		 */
+		struct Stats
+		{
+			unsigned long      requests  = 0;
+			unsigned long long depth_sum = 0;
+			unsigned           max_depth = 0;
+		} _stats { };
+
+		Genode::Constructible<Timer::Connection> _timer { };
+
+		Genode::Signal_handler<Lx_block_driver> _stats_handler {
+			_env.ep(), *this, &Lx_block_driver::_log_stats };
+
+		void _log_stats()
+		{
+			unsigned long const avg_x10 = _stats.requests
+			                            ? (10*_stats.depth_sum)/_stats.requests : 0;
+
+			Genode::log("queue depth: current ", _in_flight, " "
+			            "max ", _stats.max_depth, " "
+			            "avg ", avg_x10/10, ".", avg_x10%10, ", "
+			            "requests ", _stats.requests);
+		}
+
+		/*
+		 * With 'O_DIRECT', writes of a block size below 'DIRECT_ALIGN' are
+		 * performed as read-modify-write of the enclosing aligned range.
+		 * Such writes are serialized by '_rmw_lock' so that concurrent
+		 * writes to neighbouring blocks of the same page do not overwrite
+		 * each other.
+		 */
+		Genode::Lock _rmw_lock { };
+
+		bool _rmw_needed() const { return _direct && (_block_size % DIRECT_ALIGN) != 0; }
+
+		/**
+		 * Read aligned page at 'offset' into 'dst'
+		 */
+		bool _read_page(char *dst, off_t offset)
+		{
+			ssize_t const n = pread(_fd, dst, DIRECT_ALIGN, offset);
+			if (n == -1)
+				perror("pread");
+
+			return n == DIRECT_ALIGN;
+		}
+
+		void _execute_unsynchronized(Request &request)
+		{
+			char *buffer = request.buffer;
+
+			/*
+			 * 'O_DIRECT' requires the buffer, the offset, and the length to
+			 * be aligned. Otherwise, the I/O covers the enclosing aligned
+			 * range using a bounce buffer.
+			 */
+			off_t const mask  = _direct ? DIRECT_ALIGN - 1 : 0;
+			off_t const start = request.offset & ~mask;
+			off_t const end   = (request.offset + request.count + mask) & ~mask;
+
+			size_t const size = end - start;
+			size_t const head = request.offset - start;
+
+			bool const bounce = _direct
+			                 && ((Genode::addr_t)buffer % DIRECT_ALIGN
+			                  || size != request.count);
+
+			if (bounce) {
+				void *ptr = nullptr;
+				if (posix_memalign(&ptr, DIRECT_ALIGN, size)) {
+					request.success = false;
+					return;
+				}
+				buffer = (char *)ptr;
+
+				if (request.write) {
+
+					/* read partially written pages at both ends */
+					bool ok = true;
+					if (head)
+						ok = _read_page(buffer, start);
+
+					if (ok && (off_t)(request.offset + request.count) != end
+					 && (!head || size > DIRECT_ALIGN))
+						ok = _read_page(buffer + size - DIRECT_ALIGN, end - DIRECT_ALIGN);
+
+					if (!ok) {
+						free(buffer);
+						request.success = false;
+						return;
+					}
+
+					Genode::memcpy(buffer + head, request.buffer, request.count);
+				}
+			}
+
+			ssize_t const n = request.write
+			                ? pwrite(_fd, buffer, size, start)
+			                : pread (_fd, buffer, size, start);
+
+			if (n == -1)
+				perror(request.write ? "pwrite" : "pread");
+
+			request.success = (n == (ssize_t)size);
+
+			if (bounce) {
+				if (!request.write && request.success)
+					Genode::memcpy(request.buffer, buffer + head, request.count);
+				free(buffer);
+			}
+		}
+
+		/**
+		 * Perform host I/O for one request, called by the I/O threads
+		 */
+		void _execute(Request &request)
+		{
+			if (request.write && _rmw_needed()) {
+				Genode::Lock::Guard guard(_rmw_lock);
+				_execute_unsynchronized(request);
+			} else {
+				_execute_unsynchronized(request);
+			}
+		}
+
+		void _process_requests()
+		{
+			for (;;) {
+				_pending_sem.down();
+
+				Request request;
+				{
+					Genode::Lock::Guard guard(_lock);
+					request = _pending.dequeue();
+				}
+
+				_execute(request);
+
+				{
+					Genode::Lock::Guard guard(_lock);
+					_completed.enqueue(request);
+
+					if (--_in_progress == 0)
+						for (; _sync_waiters; _sync_waiters--)
+							_idle_sem.up();
+				}
+
+				Genode::Signal_transmitter(_completion_handler).submit();
+			}
+		}
+
+		/**
+		 * Acknowledge completed requests in the order of their completion
+		 */
+		void _handle_completions()
+		{
+			for (;;) {
+				Request request;
+				{
+					Genode::Lock::Guard guard(_lock);
+					if (_completed.empty())
+						return;
+
+					request = _completed.dequeue();
+				}
+
+				_in_flight--;
+				ack_packet(request.packet, request.success);
+			}
+		}
+
+		void _submit(Request const &request)
+		{
+			if (_in_flight >= _queue_depth)
+				throw Request_congestion();
+
+			_in_flight++;
+
+			_stats.requests++;
+			_stats.depth_sum += _in_flight;
+			_stats.max_depth  = Genode::max(_stats.max_depth, _in_flight);
+
+			{
+				Genode::Lock::Guard guard(_lock);
+				_pending.enqueue(request);
+				_in_progress++;
+			}
+			_pending_sem.up();
+		}
+
 	public:
 
 		struct Could_not_open_file : Genode::Exception { };
 
-		Lx_block_driver(Genode::Env &env, Genode::Xml_node config)
-		: Block::Driver(env.ram()), _env(env)
+		Lx_block_driver(Genode::Env &env, Genode::Allocator &alloc,
+		                Genode::Xml_node config)
+		:
+			Block::Driver(env.ram()), _env(env), _alloc(alloc),
+			_direct(xml_attr_ok(config, "direct")),
+			_queue_depth(Genode::min(config.attribute_value("queue_depth", 64U),
+			                         (unsigned)MAX_QUEUE_DEPTH))
 		{
 			Genode::String<256> file;
 			try {
@@ -77,10 +367,18 @@ class Lx_block_driver : public Block::Driver
 				throw Could_not_open_file();
 			}
 
-			_block_count = st.st_size / _block_size;
+			/*
+			 * With 'O_DIRECT', the I/O covers whole aligned pages. Hence,
+			 * a partial page at the end of the file is not used.
+			 */
+			off_t const usable = _direct ? st.st_size & ~(off_t)(DIRECT_ALIGN - 1)
+			                             : st.st_size;
+
+			_block_count = usable / _block_size;
 
 			/* open file */
-			_fd = open(file.string(), writeable ? O_RDWR : O_RDONLY);
+			_fd = open(file.string(), (writeable ? O_RDWR : O_RDONLY)
+			                        | (_direct ? O_DIRECT : 0));
 			if (_fd == -1) {
 				perror("open");
 				throw Could_not_open_file();
@@ -91,11 +389,32 @@ class Lx_block_driver : public Block::Driver
 				_block_ops.set_operation(Block::Packet_descriptor::WRITE);
 			}
 
+			_num_io_threads = Genode::max(1U, Genode::min(config.attribute_value("io_threads", 4U),
+			                                               (unsigned)MAX_IO_THREADS));
+			for (unsigned i = 0; i < _num_io_threads; i++)
+				_io_threads[i] = new (_alloc) Io_thread(_env, *this);
+
+			unsigned const stats_interval_ms =
+				config.attribute_value("stats_interval_ms", 0U);
+
+			if (stats_interval_ms) {
+				_timer.construct(_env);
+				_timer->sigh(_stats_handler);
+				_timer->trigger_periodic(stats_interval_ms*1000);
+			}
+
 			Genode::log("Provide '", file.string(), "' as block device "
 			            "block_size: ", _block_size, " block_count: ",
-			            _block_count, " writeable: ", writeable ? "yes" : "no");
+			            _block_count, " writeable: ", writeable ? "yes" : "no", " "
+			            "direct: ", _direct ? "yes" : "no", " "
+			            "io_threads: ", _num_io_threads, " "
+			            "queue_depth: ", _queue_depth);
 		}
 
+		/*
+		 * The I/O threads block forever and are not destructed. As the
+		 * driver lives as long as the component, this is not a problem.
+		 */
 		~Lx_block_driver() { close(_fd); }
 
 
@@ -117,16 +436,14 @@ class Lx_block_driver : public Block::Driver
 				throw Io_error();
 			}
 
-			off_t const offset = block_number * _block_size;
-			size_t const count = block_count * _block_size;
-
-			ssize_t const n = pread(_fd, buffer, count, offset);
-			if (n == -1) {
-				perror("pread");
-				throw Io_error();
-			}
+			Request request;
+			request.packet = packet;
+			request.buffer = buffer;
+			request.offset = block_number * _block_size;
+			request.count  = block_count * _block_size;
+			request.write  = false;
 
-			ack_packet(packet);
+			_submit(request);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -139,19 +456,35 @@ class Lx_block_driver : public Block::Driver
 				throw Io_error();
 			}
 
-			off_t const offset = block_number * _block_size;
-			size_t const count = block_count * _block_size;
+			Request request;
+			request.packet = packet;
+			request.buffer = const_cast<char *>(buffer);
+			request.offset = block_number * _block_size;
+			request.count  = block_count * _block_size;
+			request.write  = true;
 
-			ssize_t const n = pwrite(_fd, buffer, count, offset);
-			if (n == -1) {
-				perror("pwrite");
-				throw Io_error();
+			_submit(request);
+		}
+
+		/**
+		 * Wait until all submitted requests are executed by the host
+		 */
+		void sync() override
+		{
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+					if (_in_progress == 0)
+						break;
+
+					_sync_waiters++;
+				}
+				_idle_sem.down();
 			}
 
-			ack_packet(packet);
+			if (_block_ops.supported(Block::Packet_descriptor::WRITE))
+				fdatasync(_fd);
 		}
-
-		void sync() { }
 };
 
 
@@ -166,9 +499,10 @@ struct Main
 	{
 		Genode::Constructible<Lx_block_driver> _driver { };
 
-		Factory(Genode::Env &env, Genode::Xml_node config)
+		Factory(Genode::Env &env, Genode::Allocator &alloc,
+		        Genode::Xml_node config)
 		{
-			_driver.construct(env, config);
+			_driver.construct(env, alloc, config);
 		}
 
 		~Factory() { _driver.destruct(); }
@@ -179,7 +513,7 @@ struct Main
 
 		Block::Driver *create() { return &*_driver; }
 		void destroy(Block::Driver *) { }
-	} factory { _env, _config_rom.xml() };
+	} factory { _env, _heap, _config_rom.xml() };
 
 	Block::Root root { _env.ep(), _heap, _env.rm(), factory,
 	                   xml_attr_ok(_config_rom.xml(), "writeable") };
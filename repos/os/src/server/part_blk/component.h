@@ -18,6 +18,8 @@
 #include <base/component.h>
 #include <os/session_policy.h>
 #include <root/component.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
 #include <block_session/rpc_object.h>
 
 #include "gpt.h"
@@ -26,11 +28,27 @@ namespace Block {
 
 	using namespace Genode;
 
+	struct Tx_buffer;
 	class Session_component;
 	class Root;
 };
 
 
+/**
+ * Packet buffer of a session
+ *
+ * The buffer is either a RAM dataspace of its own or, in zero-copy mode, a
+ * window of the back-end packet buffer made available to the client as a
+ * managed dataspace.
+ */
+struct Block::Tx_buffer
+{
+	Dataspace_capability    ds     { };
+	Driver::Window         *window { nullptr };
+	Capability<Region_map>  rm     { };
+};
+
+
 class Block::Session_component : public  Block::Session_rpc_object,
                                  private List<Block::Session_component>::Element,
                                  public  Block_dispatcher
@@ -45,7 +63,7 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		Session_component(Session_component const &);
 		Session_component &operator = (Session_component const &);
 
-		Ram_dataspace_capability          _rq_ds;
+		Tx_buffer                         _tx_buffer;
 		addr_t                            _rq_phys;
 		Partition                        *_partition;
 		Signal_handler<Session_component> _sink_ack;
@@ -99,8 +117,19 @@ class Block::Session_component : public  Block::Session_rpc_object,
 				return;
 			}
 
+			/* the back end must not access memory outside the packet */
+			if (_tx_buffer.window && (!tx_sink()->packet_valid(_p_to_handle)
+			 || _p_to_handle.size() < cnt*_driver.blk_size())) {
+				_ack_packet(_p_to_handle);
+				return;
+			}
+
 			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
+				if (_tx_buffer.window)
+					_driver.io(write, off, cnt, *_tx_buffer.window,
+					           _p_to_handle.offset(), *this, _p_to_handle);
+				else
+					_driver.io(write, off, cnt, addr, *this, _p_to_handle);
 			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
 				if (!_req_queue_full) {
 					_req_queue_full = true;
@@ -137,15 +166,15 @@ class Block::Session_component : public  Block::Session_rpc_object,
 		/**
 		 * Constructor
 		 */
-		Session_component(Ram_dataspace_capability  rq_ds,
-		                  Partition                *partition,
-		                  Genode::Entrypoint       &ep,
-		                  Genode::Region_map       &rm,
-		                  Block::Driver            &driver,
-		                  bool                      writeable)
-		: Session_rpc_object(rm, rq_ds, ep.rpc_ep()),
-		  _rq_ds(rq_ds),
-		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
+		Session_component(Tx_buffer           tx_buffer,
+		                  Partition          *partition,
+		                  Genode::Entrypoint &ep,
+		                  Genode::Region_map &rm,
+		                  Block::Driver      &driver,
+		                  bool                writeable)
+		: Session_rpc_object(rm, tx_buffer.ds, ep.rpc_ep()),
+		  _tx_buffer(tx_buffer),
+		  _rq_phys(Dataspace_client(_tx_buffer.ds).phys_addr()),
 		  _partition(partition),
 		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(ep, *this, &Session_component::_packet_avail),
@@ -167,12 +196,14 @@ class Block::Session_component : public  Block::Session_rpc_object,
 				wait_queue().remove(this);
 		}
 
-		Ram_dataspace_capability const rq_ds() const { return _rq_ds; }
+		Tx_buffer const &tx_buffer() const { return _tx_buffer; }
 		Partition *partition() { return _partition; }
 
 		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
 		{
-			if (request.operation() == Block::Packet_descriptor::READ) {
+			/* in zero-copy mode, the back end has read into the client buffer */
+			if (request.operation() == Block::Packet_descriptor::READ
+			 && !_tx_buffer.window) {
 				void *src =
 					_driver.session().tx()->packet_content(reply);
 				Genode::size_t sz =
@@ -241,13 +272,58 @@ class Block::Root :
 		Block::Driver          &_driver;
 		Block::Partition_table &_table;
 
+		bool const _zero_copy = _config.attribute_value("zero_copy", false);
+
+		Constructible<Rm_connection> _rm { };
+
+		/**
+		 * Provide window of the back-end buffer as client buffer
+		 *
+		 * \return false if no window could be provided
+		 */
+		bool _alloc_window(size_t size, Tx_buffer &tx_buffer)
+		{
+			size = align_addr(size, 12);
+
+			try {
+				tx_buffer.window = &_driver.alloc_window(size);
+
+				if (!_rm.constructed())
+					_rm.construct(_env);
+
+				tx_buffer.rm = _rm->create(size);
+
+				Region_map_client region_map(tx_buffer.rm);
+				region_map.attach_at(_driver.buffer_ds(), 0, size,
+				                     tx_buffer.window->offset());
+				tx_buffer.ds = region_map.dataspace();
+				return true;
+			}
+			catch (...) { }
+
+			if (tx_buffer.rm.valid())
+				_rm->destroy(tx_buffer.rm);
+
+			if (tx_buffer.window)
+				_driver.release_window(*tx_buffer.window);
+
+			tx_buffer = Tx_buffer();
+			return false;
+		}
+
 	protected:
 
 		void _destroy_session(Session_component *session) override
 		{
-			Ram_dataspace_capability rq_ds = session->rq_ds();
+			Tx_buffer const tx_buffer = session->tx_buffer();
 			Genode::Root_component<Session_component>::_destroy_session(session);
-			_env.ram().free(rq_ds);
+
+			if (tx_buffer.window) {
+				_rm->destroy(tx_buffer.rm);
+				_driver.release_window(*tx_buffer.window);
+			} else {
+				_env.ram().free(static_cap_cast<Ram_dataspace>(tx_buffer.ds));
+			}
 		}
 
 		/**
@@ -313,14 +389,22 @@ class Block::Root :
 			if (writeable)
 				writeable = Arg_string::find_arg(args, "writeable").bool_value(true);
 
-			Ram_dataspace_capability ds_cap;
-			ds_cap = _env.ram().alloc(tx_buf_size);
+			Tx_buffer tx_buffer;
+			bool const zero_copy = _zero_copy && _alloc_window(tx_buf_size, tx_buffer);
+
+			if (_zero_copy && !zero_copy)
+				warning("no zero-copy buffer available for '", label_str, "'");
+
+			if (!zero_copy)
+				tx_buffer.ds = _env.ram().alloc(tx_buf_size);
+
 			Session_component *session = new (md_alloc())
-				Session_component(ds_cap, _table.partition(num),
+				Session_component(tx_buffer, _table.partition(num),
 				                  _env.ep(), _env.rm(), _driver,
 				                  writeable);
 
-			log("session opened at partition ", num, " for '", label_str, "'");
+			log("session opened at partition ", num, " for '", label_str, "'",
+			    zero_copy ? " (zero copy)" : "");
 			return session;
 		}
 
@@ -47,30 +47,71 @@ class Block::Driver
 {
 	public:
 
+	/**
+	 * Part of the back-end packet buffer shared with a client
+	 *
+	 * A window is handed out to a client as its packet buffer. Requests
+	 * of the client then refer to the back-end packet buffer directly,
+	 * which spares the copying of the payload.
+	 */
+	class Window
+	{
+		private:
+
+			friend class Driver;
+
+			Genode::addr_t const _offset;
+			Genode::size_t const _size;
+
+			unsigned _in_flight = 0;
+			bool     _released  = false;
+
+			Window(Genode::addr_t offset, Genode::size_t size)
+			: _offset(offset), _size(size) { }
+
+		public:
+
+			/**
+			 * Return offset of the window within the back-end buffer
+			 */
+			Genode::addr_t offset() const { return _offset; }
+	};
+
+	class Window_unavailable : Genode::Exception { };
+
 	class Request : public Genode::List<Request>::Element
 	{
 		private:
 
-			Block_dispatcher &_dispatcher;
+			Block_dispatcher *_dispatcher;
 			Packet_descriptor _cli;
 			Packet_descriptor _srv;
+			Window           *_window;
 
 		public:
 
 			Request(Block_dispatcher &d,
 			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
+			        Packet_descriptor &srv,
+			        Window *window = nullptr)
+			: _dispatcher(&d), _cli(cli), _srv(srv), _window(window) {}
 
 			bool handle(Packet_descriptor& reply)
 			{
-				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
+				bool ret = reply == _srv && reply.offset() == _srv.offset();
+				if (ret && _dispatcher) _dispatcher->dispatch(_cli, reply);
 				return ret;
 			}
 
 			bool same_dispatcher(Block_dispatcher &same) {
-				return &same == &_dispatcher; }
+				return &same == _dispatcher; }
+
+			/**
+			 * Keep request until acknowledged but drop its dispatcher
+			 */
+			void orphan() { _dispatcher = nullptr; }
+
+			Window *window() { return _window; }
 	};
 
 	private:
@@ -87,26 +128,52 @@ class Block::Driver
 		Genode::Signal_handler<Driver> _source_submit;
 		Block::Session::Operations     _ops { };
 
+		Genode::Heap &_heap;
+
 		void _ready_to_submit();
 
+		void _free_window_if_unused(Window &window)
+		{
+			if (!window._released || window._in_flight)
+				return;
+
+			_block_alloc.free((void *)window._offset, window._size);
+			Genode::destroy(&_heap, &window);
+		}
+
 		void _ack_avail()
 		{
 			/* check for acknowledgements */
 			while (_session.tx()->ack_avail()) {
 				Packet_descriptor p = _session.tx()->get_acked_packet();
+				Window *window = nullptr;
 				for (Request *r = _r_list.first(); r; r = r->next()) {
 					if (r->handle(p)) {
+						window = r->window();
 						_r_list.remove(r);
 						Genode::destroy(&_r_slab, r);
 						break;
 					}
 				}
-				_session.tx()->release_packet(p);
+
+				/* packets within a window stay allocated with the window */
+				if (window) {
+					window->_in_flight--;
+					_free_window_if_unused(*window);
+				} else {
+					_session.tx()->release_packet(p);
+				}
 			}
 
 			_ready_to_submit();
 		}
 
+		Packet_descriptor::Opcode _opcode(bool write)
+		{
+			return write ? Block::Packet_descriptor::WRITE
+			             : Block::Packet_descriptor::READ;
+		}
+
 	public:
 
 		Driver(Genode::Env &env, Genode::Heap &heap)
@@ -114,7 +181,8 @@ class Block::Driver
 		  _block_alloc(&heap),
 		  _session(env, &_block_alloc, 4 * 1024 * 1024),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
-		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit)
+		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
+		  _heap(heap)
 		{
 			_session.info(&_blk_cnt, &_blk_size, &_ops);
 		}
@@ -138,12 +206,9 @@ class Block::Driver
 			if (!_session.tx()->ready_to_submit())
 				throw Block::Session::Tx::Source::Packet_alloc_failed();
 
-			Block::Packet_descriptor::Opcode op = write
-			    ? Block::Packet_descriptor::WRITE
-			    : Block::Packet_descriptor::READ;
 			Genode::size_t size = _blk_size * cnt;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
-			                    op,  nr, cnt);
+			                    _opcode(write),  nr, cnt);
 			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
 			_r_list.insert(r);
 
@@ -154,6 +219,57 @@ class Block::Driver
 			_session.tx()->submit_packet(p);
 		}
 
+		/**
+		 * Submit request for payload located within a window
+		 *
+		 * \param offset  offset of the payload relative to the window
+		 */
+		void io(bool write, sector_t nr, Genode::size_t cnt, Window &window,
+		        Genode::off_t offset, Block_dispatcher &dispatcher,
+		        Packet_descriptor &cli)
+		{
+			if (!_session.tx()->ready_to_submit())
+				throw Block::Session::Tx::Source::Packet_alloc_failed();
+
+			Packet_descriptor p(Packet_descriptor(window._offset + offset,
+			                                      _blk_size * cnt),
+			                    _opcode(write), nr, cnt);
+			Request *r = new (&_r_slab) Request(dispatcher, cli, p, &window);
+			_r_list.insert(r);
+			window._in_flight++;
+
+			_session.tx()->submit_packet(p);
+		}
+
+		/**
+		 * Return back-end packet buffer, which contains the windows
+		 */
+		Genode::Dataspace_capability buffer_ds() {
+			return _session.tx()->dataspace(); }
+
+		/**
+		 * Reserve page-aligned window of the back-end packet buffer
+		 *
+		 * \throw Window_unavailable
+		 */
+		Window &alloc_window(Genode::size_t size)
+		{
+			void *offset = nullptr;
+			if (_block_alloc.alloc_aligned(size, &offset, 12).error())
+				throw Window_unavailable();
+
+			return *new (&_heap) Window((Genode::addr_t)offset, size);
+		}
+
+		/**
+		 * Release window, the window is freed once its requests are done
+		 */
+		void release_window(Window &window)
+		{
+			window._released = true;
+			_free_window_if_unused(window);
+		}
+
 		void remove_dispatcher(Block_dispatcher &dispatcher)
 		{
 			for (Request *r = _r_list.first(); r;) {
@@ -165,6 +281,15 @@ class Block::Driver
 				Request *remove = r;
 				r = r->next();
 
+				/*
+				 * Requests within a window must be kept until acknowledged
+				 * because the window memory must not be reused before.
+				 */
+				if (remove->window()) {
+					remove->orphan();
+					continue;
+				}
+
 				_r_list.remove(remove);
 				Genode::destroy(&_r_slab, remove);
 			}
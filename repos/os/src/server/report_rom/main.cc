@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/heap.h>
 #include <base/env.h>
+#include <base/entrypoint_pool.h>
 #include <report_rom/rom_service.h>
 #include <report_rom/report_service.h>
 #include <base/attached_rom_dataspace.h>
@@ -32,14 +33,28 @@ struct Report_rom::Main
 
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), config_rom };
+	Rom::View_factory views { env };
+
+	Rom::Registry rom_registry { sliced_heap, env.ram(), env.rm(), views, config_rom };
 
 	Genode::Attached_rom_dataspace config_rom { env, "config" };
 
 	bool verbose = config_rom.xml().attribute_value("verbose", false);
 
-	Report::Root report_root { env, sliced_heap, rom_registry, verbose };
-	Rom   ::Root    rom_root { env, sliced_heap, rom_registry };
+	/*
+	 * Entrypoints for serving the report and ROM sessions
+	 *
+	 * The root interfaces are served by the initial entrypoint, which
+	 * also performs the creation and destruction of all sessions.
+	 */
+	Genode::Entrypoint_pool ep_pool {
+		env, sliced_heap, config_rom.xml().attribute_value("entrypoints", 1U),
+		16*1024*sizeof(long), "report_rom_ep",
+		Genode::Entrypoint_pool::Pinned {
+			config_rom.xml().attribute_value("pin_entrypoints", false) } };
+
+	Report::Root report_root { env, ep_pool, sliced_heap, rom_registry, verbose };
+	Rom   ::Root    rom_root { env, ep_pool, sliced_heap, rom_registry };
 
 	Main(Genode::Env &env) : env(env)
 	{
@@ -28,6 +28,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		Genode::Allocator              &_md_alloc;
 		Genode::Ram_session            &_ram;
 		Genode::Region_map             &_rm;
+		View_factory                   &_views;
 		Genode::Attached_rom_dataspace &_config_rom;
 
 		Module_list _modules { };
@@ -72,7 +73,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_md_alloc, _ram, _rm, _views, name, _read_write_policy, _read_write_policy);
 
 			_modules.insert(module);
 			return *module;
@@ -148,9 +149,10 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 		Registry(Genode::Allocator &md_alloc,
 		         Genode::Ram_session &ram, Genode::Region_map &rm,
+		         View_factory &views,
 		         Genode::Attached_rom_dataspace &config_rom)
 		:
-			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom)
+			_md_alloc(md_alloc), _ram(ram), _rm(rm), _views(views), _config_rom(config_rom)
 		{ }
 
 		Module &lookup(Writer &writer, Module::Name const &name) override
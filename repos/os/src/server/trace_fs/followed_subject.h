@@ -43,38 +43,47 @@ class Trace_fs::Followed_subject : public Directory
 
 				struct Process_entry
 				{
-					virtual size_t operator()(Genode::Trace::Buffer::Entry&) = 0;
+					virtual size_t operator()(Genode::Trace::Buffer const &,
+					                          Genode::Trace::Buffer::Cursor &) = 0;
 				};
 
 			private:
 
-				Genode::Trace::Buffer       *buffer;
-				Genode::Trace::Buffer::Entry current_entry;
+				Genode::Trace::Buffer         *buffer;
+				Genode::Trace::Buffer::Cursor  cursor;
 
+				unsigned long reported_lost = 0;
 
 			public:
 
 			Trace_buffer_manager(Genode::Region_map           &rm,
 				                 Genode::Dataspace_capability  ds_cap)
 			:
-				buffer(rm.attach(ds_cap)),
-				current_entry(buffer->first())
+				buffer(rm.attach(ds_cap))
 			{ }
 
 			size_t dump_entry(Process_entry &process)
 			{
-				size_t len = process(current_entry);
-
-				current_entry = buffer->next(current_entry);
-				return len;
+				return process(*buffer, cursor);
 			}
 
 			bool last_entry() const
 			{
-				return current_entry.last();
+				return !buffer->available(cursor);
 			}
 
-			void rewind() { current_entry = buffer->first(); }
+			/**
+			 * Return number of entries lost since the last call
+			 *
+			 * Entries get lost if the traced thread overwrites them
+			 * before they are dumped.
+			 */
+			unsigned long lost_entries()
+			{
+				unsigned long const lost = cursor.lost() - reported_lost;
+				reported_lost = cursor.lost();
+				return lost;
+			}
 		};
 
 
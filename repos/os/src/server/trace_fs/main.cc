@@ -205,28 +205,31 @@ class Trace_fs::Trace_file_system
 				size_t capacity() const { return CAPACITY; }
 
 				/**
-				 * Return data of the processed Trace::Buffer::Entry
+				 * Return data of the processed Trace::Buffer entry
 				 *
 				 * \return pointer to data
 				 */
 				char const *data() const { return _buf; }
 
 				/**
-				 * Functor for processing a Trace:Buffer::Entry
+				 * Functor for processing a Trace:Buffer entry
 				 *
-				 * \param entry reference of Trace::Buffer::Entry
+				 * \param buffer trace buffer to read from
+				 * \param cursor reading position within the trace buffer
 				 *
-				 * \return length of processed Trace::Buffer::Entry
+				 * \return length of processed entry, 0 if there is no entry
 				 */
-				Genode::size_t operator()(Genode::Trace::Buffer::Entry &entry)
+				Genode::size_t operator()(Genode::Trace::Buffer const &buffer,
+				                          Genode::Trace::Buffer::Cursor &cursor)
 				{
-					Genode::size_t len = Genode::min(entry.length() + 1, CAPACITY);
-					Genode::memcpy(_buf, entry.data(), len);
-					_buf[len - 1] = '\n';
+					Genode::size_t const len = buffer.read(cursor, _buf, CAPACITY - 1);
+					if (len == 0)
+						return 0;
 
-					_length = len;
+					_buf[len] = '\n';
+					_length = len + 1;
 
-					return len;
+					return _length;
 				}
 		};
 
@@ -265,19 +268,22 @@ class Trace_fs::Trace_file_system
 
 			Process_entry<512> process_entry;
 
-			while (!manager->last_entry()) {
-				size_t len = manager->dump_entry(process_entry);
+			for (;;) {
+				size_t const len = manager->dump_entry(process_entry);
+
+				/* record events overwritten before we could read them */
+				if (unsigned long const lost = manager->lost_entries()) {
+					Genode::String<64> const msg("<", lost, " events lost>\n");
+					try { subject->events_file.append(msg.string(), msg.length() - 1); }
+					catch (...) { Genode::error("could not write entry"); }
+				}
 
 				if (len == 0)
-					continue;
+					break;
 
 				try { subject->events_file.append(process_entry.data(), len); }
 				catch (...) { Genode::error("could not write entry"); }
 			}
-
-			if (manager->last_entry()) {
-				manager->rewind();
-			}
 		}
 
 		/**
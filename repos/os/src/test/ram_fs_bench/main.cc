@@ -0,0 +1,389 @@
+/*
+ * \brief  Throughput of the RAM fs chunk and extent data structures
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The benchmark compares the 'Chunk_index' hierarchy formerly used by
+ * ram_fs and the VFS ram plugin with the 'Extent_store' that replaced it.
+ * Before taking any measurements, the content of the 'Extent_store' is
+ * checked against a reference buffer for a series of writes, punches, and
+ * truncations.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <ram_fs/chunk.h>
+#include <ram_fs/extent.h>
+
+using namespace Genode;
+using namespace File_system;
+
+
+enum {
+	FILE_SIZE    = 64*1024*1024,
+	BLOCK_SIZE   = 64*1024,
+	RANDOM_SIZE  = 4096,
+	RANDOM_OPS   = 16*1024,
+	SPARSE_SIZE  = 1024*1024*1024,
+	SPARSE_STEP  = 1024*1024,
+	MiB          = 1024*1024,
+};
+
+
+/**
+ * Allocator wrapper that counts the allocations
+ */
+struct Counting_allocator : Allocator
+{
+	Allocator &wrapped;
+
+	unsigned long count = 0;
+
+	Counting_allocator(Allocator &wrapped) : wrapped(wrapped) { }
+
+	bool alloc(size_t size, void **out_addr) override
+	{
+		count++;
+		return wrapped.alloc(size, out_addr);
+	}
+
+	void free(void *addr, size_t size) override { wrapped.free(addr, size); }
+
+	size_t overhead(size_t size) const override { return wrapped.overhead(size); }
+	bool   need_size_for_free()  const override { return wrapped.need_size_for_free(); }
+};
+
+
+/**
+ * Allocator wrapper that denies allocations above a size limit
+ *
+ * Once 'exhausted' is set, all allocations fail with 'Out_of_ram'.
+ */
+struct Limited_allocator : Allocator
+{
+	Allocator &wrapped;
+
+	size_t const max_size;
+
+	bool exhausted = false;
+
+	unsigned long denied = 0;
+
+	Limited_allocator(Allocator &wrapped, size_t max_size)
+	: wrapped(wrapped), max_size(max_size) { }
+
+	bool alloc(size_t size, void **out_addr) override
+	{
+		if (exhausted) {
+			denied++;
+			throw Out_of_ram();
+		}
+
+		if (size > max_size) {
+			denied++;
+			return false;
+		}
+		return wrapped.alloc(size, out_addr);
+	}
+
+	void free(void *addr, size_t size) override { wrapped.free(addr, size); }
+
+	size_t overhead(size_t size) const override { return wrapped.overhead(size); }
+	bool   need_size_for_free()  const override { return wrapped.need_size_for_free(); }
+};
+
+
+/**
+ * Extent store paired with a reference buffer of the expected content
+ */
+struct Extent_check
+{
+	enum { SIZE = 4*Extent_store::MAX_EXTENT_SIZE };
+
+	Allocator    &alloc;
+	Extent_store &store;
+
+	char * const ref = (char *)alloc.alloc(SIZE);
+	char * const buf = (char *)alloc.alloc(SIZE);
+
+	Extent_check(Allocator &alloc, Extent_store &store)
+	: alloc(alloc), store(store) { memset(ref, 0, SIZE); }
+
+	~Extent_check()
+	{
+		alloc.free(buf, SIZE);
+		alloc.free(ref, SIZE);
+	}
+
+	/**
+	 * Write pattern that never contains zero, which tells data from holes
+	 */
+	void write(file_size_t offset, size_t len, unsigned seed)
+	{
+		for (size_t i = 0; i < len; i++)
+			ref[offset + i] = (char)((offset + i + seed) % 251 + 1);
+
+		store.write(ref + offset, len, offset);
+	}
+
+	void punch(file_size_t offset, size_t len)
+	{
+		memset(ref + offset, 0, len);
+		store.punch(offset, len);
+	}
+
+	void truncate(file_size_t size)
+	{
+		memset(ref + size, 0, SIZE - size);
+		store.truncate(size);
+	}
+
+	bool verify(char const *step)
+	{
+		memset(buf, 0xaa, SIZE);
+		store.read(buf, SIZE, 0);
+
+		for (size_t i = 0; i < SIZE; i++) {
+			if (buf[i] != ref[i]) {
+				error(step, ": unexpected content at offset ", i);
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+
+/**
+ * Chunk hierarchy as formerly used by ram_fs
+ */
+struct Chunk_store
+{
+	typedef Chunk<4096>                     Chunk_level_3;
+	typedef Chunk_index<128, Chunk_level_3> Chunk_level_2;
+	typedef Chunk_index<64,  Chunk_level_2> Chunk_level_1;
+	typedef Chunk_index<64,  Chunk_level_1> Chunk_level_0;
+
+	static constexpr char const *name = "chunk";
+
+	Chunk_level_0 chunk;
+
+	Chunk_store(Allocator &alloc) : chunk(alloc, 0) { }
+
+	void write(char const *src, size_t len, file_size_t offset) {
+		chunk.write(src, len, offset); }
+
+	void read(char *dst, size_t len, file_size_t offset) {
+		chunk.read(dst, len, offset); }
+
+	void truncate(file_size_t size)
+	{
+		if (size < chunk.used_size())
+			chunk.truncate(size);
+	}
+};
+
+
+struct Extent_store_adapter
+{
+	static constexpr char const *name = "extent";
+
+	Extent_store extents;
+
+	Extent_store_adapter(Allocator &alloc) : extents(alloc) { }
+
+	void write(char const *src, size_t len, file_size_t offset) {
+		extents.write(src, len, offset); }
+
+	void read(char *dst, size_t len, file_size_t offset) {
+		extents.read(dst, len, offset); }
+
+	void truncate(file_size_t size) { extents.truncate(size); }
+};
+
+
+struct Main
+{
+	Env &env;
+
+	Timer::Connection timer { env };
+
+	Heap heap { env.ram(), env.rm() };
+
+	char block[BLOCK_SIZE];
+
+	void report(char const *store, char const *test, unsigned long bytes,
+	            unsigned long start_ms, unsigned long allocs)
+	{
+		unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+		log(store, ": ", test, ": ", ms, " ms, ",
+		    (bytes/1024)/ms, " KiB/ms, ", allocs, " allocations");
+	}
+
+	bool expect(char const *what, bool condition)
+	{
+		if (!condition)
+			error(what, ": check failed");
+		return condition;
+	}
+
+	bool check_extents()
+	{
+		bool ok = true;
+
+		{
+			Extent_store store { heap };
+			Extent_check check { heap, store };
+
+			check.write(10000, 100, 1);
+			check.write(3*MiB + 5, 5000, 2);
+			ok &= check.verify("holes");
+			ok &= expect("used size", store.used_size() == 3*MiB + 5005);
+
+			/* write over the holes and the existing extents */
+			for (file_size_t off = 0; off < 2*MiB; off += BLOCK_SIZE)
+				check.write(off, BLOCK_SIZE, 3);
+			ok &= check.verify("overwrite");
+
+			check.punch(MiB + 1000, 3000);
+			ok &= check.verify("punch within extent");
+
+			check.punch(300000, 900000);
+			ok &= check.verify("punch across extents");
+
+			check.write(500000, 20000, 4);
+			ok &= check.verify("write into hole");
+
+			check.punch(3*MiB, 8192);
+			ok &= check.verify("punch of last extent");
+			ok &= expect("used size after punch", store.used_size() == 2*MiB);
+
+			/* truncated data must not reappear when the file grows again */
+			check.truncate(3*MiB/2 - 17);
+			ok &= check.verify("truncate");
+			ok &= expect("used size after truncate",
+			             store.used_size() <= 3*MiB/2 - 17);
+
+			check.write(3*MiB/2 + 4000, 10, 5);
+			ok &= check.verify("truncate then extend");
+			ok &= expect("used size after extend",
+			             store.used_size() == 3*MiB/2 + 4010);
+
+			check.write(3*MiB/2 - 17, 17, 6);
+			check.write(5*MiB/2, BLOCK_SIZE, 7);
+			ok &= check.verify("extend after truncate");
+
+			/* beyond the written data, the store reads as zero */
+			memset(block, 0xaa, RANDOM_SIZE);
+			store.read(block, RANDOM_SIZE, 2*Extent_check::SIZE);
+			bool zero = true;
+			for (size_t i = 0; i < RANDOM_SIZE; i++)
+				zero &= (block[i] == 0);
+			ok &= expect("read beyond end", zero);
+
+			check.truncate(0);
+			ok &= check.verify("truncate to zero");
+			ok &= expect("used size after truncate to zero",
+			             store.used_size() == 0);
+		}
+
+		/* extents larger than 16 KiB cannot be allocated */
+		{
+			Limited_allocator limited { heap, 20*1024 };
+			Extent_store      store   { limited };
+			Extent_check      check   { heap, store };
+
+			bool written = true;
+			try {
+				for (file_size_t off = 0; off < MiB; off += BLOCK_SIZE)
+					check.write(off, BLOCK_SIZE, 8);
+			}
+			catch (Out_of_ram) { written = false; }
+			ok &= expect("write with allocation fallback", written);
+			ok &= check.verify("allocation fallback");
+			ok &= expect("denied allocations", limited.denied > 0);
+
+			/* a failing write leaves the content written so far intact */
+			limited.exhausted = true;
+			bool out_of_ram = false;
+			try { store.write(block, BLOCK_SIZE, 2*MiB); }
+			catch (Out_of_ram) { out_of_ram = true; }
+			ok &= expect("out of RAM", out_of_ram);
+			ok &= check.verify("allocation failure");
+		}
+
+		return ok;
+	}
+
+	template <typename STORE>
+	void bench()
+	{
+		Counting_allocator alloc { heap };
+
+		STORE store { alloc };
+
+		memset(block, 0x55, sizeof(block));
+
+		unsigned long start = timer.elapsed_ms();
+		for (file_size_t off = 0; off < FILE_SIZE; off += BLOCK_SIZE)
+			store.write(block, BLOCK_SIZE, off);
+		report(STORE::name, "sequential write", FILE_SIZE, start, alloc.count);
+
+		start = timer.elapsed_ms();
+		for (file_size_t off = 0; off < FILE_SIZE; off += BLOCK_SIZE)
+			store.read(block, BLOCK_SIZE, off);
+		report(STORE::name, "sequential read ", FILE_SIZE, start, alloc.count);
+
+		/* linear congruential generator for deterministic offsets */
+		unsigned long seed = 1;
+		start = timer.elapsed_ms();
+		for (unsigned i = 0; i < RANDOM_OPS; i++) {
+			seed = seed*1103515245 + 12345;
+			file_size_t const off = (seed % (FILE_SIZE/RANDOM_SIZE))*RANDOM_SIZE;
+			store.write(block, RANDOM_SIZE, off);
+		}
+		report(STORE::name, "random write    ", RANDOM_OPS*RANDOM_SIZE, start,
+		       alloc.count);
+
+		start = timer.elapsed_ms();
+		store.truncate(0);
+		report(STORE::name, "truncate        ", FILE_SIZE, start, alloc.count);
+
+		start = timer.elapsed_ms();
+		for (file_size_t off = 0; off < SPARSE_SIZE; off += SPARSE_STEP)
+			store.write(block, RANDOM_SIZE, off);
+		report(STORE::name, "sparse write    ",
+		       (SPARSE_SIZE/SPARSE_STEP)*RANDOM_SIZE, start, alloc.count);
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- RAM fs storage benchmark ---");
+
+		if (!check_extents()) {
+			error("RAM fs storage check failed");
+			env.parent().exit(1);
+			return;
+		}
+
+		bench<Chunk_store>();
+		bench<Extent_store_adapter>();
+
+		log("--- RAM fs storage benchmark finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
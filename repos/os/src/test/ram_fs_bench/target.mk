@@ -0,0 +1,3 @@
+TARGET = test-ram_fs_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -57,19 +57,11 @@ class Trace_buffer_monitor
 
 		static constexpr size_t MAX_ENTRY_BUF = 256;
 
-		char                  _buf[MAX_ENTRY_BUF];
-		Region_map           &_rm;
-		Trace::Subject_id     _id;
-		Trace::Buffer        *_buffer;
-		Trace::Buffer::Entry  _curr_entry;
-
-		const char *_terminate_entry(Trace::Buffer::Entry const &entry)
-		{
-			size_t len = min(entry.length() + 1, MAX_ENTRY_BUF);
-			memcpy(_buf, entry.data(), len);
-			_buf[len-1] = '\0';
-			return _buf;
-		}
+		char                   _buf[MAX_ENTRY_BUF];
+		Region_map            &_rm;
+		Trace::Subject_id      _id;
+		Trace::Buffer         *_buffer;
+		Trace::Buffer::Cursor  _cursor { };
 
 	public:
 
@@ -77,8 +69,7 @@ class Trace_buffer_monitor
 		                     Trace::Subject_id     id,
 		                     Dataspace_capability  ds_cap)
 		:
-			_rm(rm), _id(id), _buffer(rm.attach(ds_cap)),
-			_curr_entry(_buffer->first())
+			_rm(rm), _id(id), _buffer(rm.attach(ds_cap))
 		{
 			log("monitor "
 				"subject:", _id.id, " "
@@ -97,17 +88,12 @@ class Trace_buffer_monitor
 			log("overflows: ", _buffer->wrapped());
 			log("read all remaining events");
 
-			for (; !_curr_entry.last(); _curr_entry = _buffer->next(_curr_entry)) {
-				/* omit empty entries */
-				if (_curr_entry.length() == 0)
-					continue;
-
-				char const * const data = _terminate_entry(_curr_entry);
-				if (data) { log(data); }
+			while (size_t const len = _buffer->read(_cursor, _buf, MAX_ENTRY_BUF - 1)) {
+				_buf[len] = '\0';
+				log(Cstring(_buf));
 			}
 
-			/* reset after we read all available entries */
-			_curr_entry = _buffer->first();
+			log("lost events: ", _cursor.lost());
 		}
 };
 
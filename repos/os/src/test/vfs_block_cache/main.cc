@@ -0,0 +1,317 @@
+/*
+ * \brief  Test for the write-back block cache of the VFS block plugin
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The cache operates on a simulated device that counts the requests. The
+ * test covers the read-modify-write of partially written blocks, the
+ * merging of adjacent dirty blocks into one request, the write-back of
+ * evicted blocks, the handling of failing write-backs, and 'sync' after
+ * random accesses compared against a reference copy of the device.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+
+/* VFS-local includes */
+#include <block_cache.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Device;
+	struct Io;
+	struct Main;
+}
+
+
+/**
+ * Simulated block device
+ */
+struct Test::Device
+{
+	enum { BLOCK_SIZE = 512, NUM_BLOCKS = 1024 };
+
+	char data[NUM_BLOCKS*BLOCK_SIZE];
+
+	unsigned long reads          = 0;
+	unsigned long writes         = 0;
+	unsigned long written_blocks = 0;
+	unsigned      last_write     = 0;  /* number of blocks */
+
+	/* writes to this range of blocks fail */
+	Block::sector_t fail_first = 0, fail_end = 0;
+
+	Device() { memset(data, 0, sizeof(data)); }
+
+	char *block(Block::sector_t nr) { return data + nr*BLOCK_SIZE; }
+
+	void reset_counters() { reads = writes = written_blocks = last_write = 0; }
+
+	bool io(Block::sector_t nr, char *buf, unsigned count, bool write)
+	{
+		if (nr + count > NUM_BLOCKS)
+			return false;
+
+		if (!write) {
+			reads++;
+			memcpy(buf, block(nr), count*BLOCK_SIZE);
+			return true;
+		}
+
+		if (nr < fail_end && nr + count > fail_first)
+			return false;
+
+		writes++;
+		written_blocks += count;
+		last_write      = count;
+		memcpy(block(nr), buf, count*BLOCK_SIZE);
+		return true;
+	}
+};
+
+
+/**
+ * I/O functor passed to the cache
+ */
+struct Test::Io
+{
+	Device &device;
+
+	bool operator () (Block::sector_t nr, char *buf, unsigned count,
+	                  bool write) const
+	{
+		return device.io(nr, buf, count, write);
+	}
+};
+
+
+struct Test::Main
+{
+	enum { BLOCK_SIZE = Device::BLOCK_SIZE };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	bool _ok = true;
+
+	void _check(char const *what, bool condition)
+	{
+		if (condition)
+			return;
+
+		error(what, " failed");
+		_ok = false;
+	}
+
+	static bool _filled(char const *ptr, size_t len, char c)
+	{
+		for (size_t i = 0; i < len; i++)
+			if (ptr[i] != c)
+				return false;
+		return true;
+	}
+
+	void _test_partial_write()
+	{
+		Device &device = *new (_heap) Device;
+		Io io { device };
+		Vfs::Block_cache cache(_heap, BLOCK_SIZE, 16);
+
+		memset(device.block(5), 'a', BLOCK_SIZE);
+
+		char const data[10] = { 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b', 'b' };
+		_check("partial write",      cache.write(5, 100, data, sizeof(data), io));
+		_check("read of old block",  device.reads == 1 && device.writes == 0);
+		_check("sync",               cache.sync(io));
+		_check("write of block",     device.writes == 1 && device.last_write == 1);
+
+		char const *block = device.block(5);
+		_check("merged content",     _filled(block, 100, 'a')
+		                          && _filled(block + 100, 10, 'b')
+		                          && _filled(block + 110, BLOCK_SIZE - 110, 'a'));
+
+		destroy(_heap, &device);
+		log("partial-block write: reads=1 writes=1");
+	}
+
+	void _test_merged_runs()
+	{
+		Device &device = *new (_heap) Device;
+		Io io { device };
+		Vfs::Block_cache cache(_heap, BLOCK_SIZE, 32);
+
+		char data[BLOCK_SIZE];
+		memset(data, 'c', BLOCK_SIZE);
+
+		/* write full blocks in reverse order, no read needed */
+		for (unsigned i = 8; i > 0; i--)
+			cache.write(10 + i - 1, 0, data, BLOCK_SIZE, io);
+
+		_check("no reads for full blocks", device.reads == 0);
+		_check("sync",                     cache.sync(io));
+		_check("single merged request",    device.writes == 1 && device.last_write == 8);
+		_check("merged content",           _filled(device.block(10), 8*BLOCK_SIZE, 'c'));
+
+		/* a second sync has nothing to write */
+		cache.sync(io);
+		_check("clean after sync", device.writes == 1);
+
+		log("merged dirty run: ", device.last_write, " blocks in one request");
+		destroy(_heap, &device);
+	}
+
+	void _test_eviction()
+	{
+		Device &device = *new (_heap) Device;
+		Io io { device };
+		Vfs::Block_cache cache(_heap, BLOCK_SIZE, 8);
+
+		char data[BLOCK_SIZE];
+		memset(data, 'd', BLOCK_SIZE);
+
+		for (unsigned i = 0; i < 4; i++)
+			cache.write(i, 0, data, BLOCK_SIZE, io);
+
+		/* touch other blocks until the dirty blocks are evicted */
+		char buf[BLOCK_SIZE];
+		for (unsigned i = 0; i < 8; i++)
+			cache.read(100 + i, 1, 0, buf, BLOCK_SIZE, io);
+
+		_check("write-back on eviction", device.written_blocks == 4
+		                              && _filled(device.block(0), 4*BLOCK_SIZE, 'd'));
+
+		log("write-back on eviction: ", device.writes, " request(s)");
+		destroy(_heap, &device);
+	}
+
+	void _test_failing_write_back()
+	{
+		Device &device = *new (_heap) Device;
+		Io io { device };
+		Vfs::Block_cache cache(_heap, BLOCK_SIZE, 8);
+
+		char data[BLOCK_SIZE];
+		memset(data, 'e', BLOCK_SIZE);
+
+		device.fail_first = 50;
+		device.fail_end   = 51;
+
+		cache.write(50, 0, data, BLOCK_SIZE, io);
+
+		/* misses must not fail although the dirty block cannot be evicted */
+		char buf[BLOCK_SIZE];
+		bool all_read = true;
+		for (unsigned i = 0; i < 32; i++)
+			all_read &= cache.read(200 + i, 1, 0, buf, BLOCK_SIZE, io);
+
+		_check("misses despite failing write-back", all_read);
+		_check("failing sync",                      !cache.sync(io));
+
+		/* the dirty block is still cached */
+		_check("read of unwritten block", cache.read(50, 1, 0, buf, BLOCK_SIZE, io)
+		                               && _filled(buf, BLOCK_SIZE, 'e'));
+
+		device.fail_end = 0;
+		_check("sync after recovery", cache.sync(io)
+		                           && _filled(device.block(50), BLOCK_SIZE, 'e'));
+
+		destroy(_heap, &device);
+		log("failing write-back: dirty block retained");
+	}
+
+	void _test_random()
+	{
+		enum { NUM_OPS = 20000, MAX_LEN = 4*BLOCK_SIZE };
+
+		Device &device    = *new (_heap) Device;
+		Device &reference = *new (_heap) Device;
+		Io io { device };
+		Vfs::Block_cache cache(_heap, BLOCK_SIZE, 64);
+
+		static char buf[MAX_LEN];
+
+		unsigned long seed = 1;
+		auto random = [&] () {
+			seed = seed*1103515245 + 12345;
+			return (unsigned)(seed >> 16);
+		};
+
+		size_t const size = sizeof(device.data);
+
+		for (unsigned i = 0; i < NUM_OPS && _ok; i++) {
+
+			size_t const offset = random() % size;
+			size_t const len    = min((size_t)(random() % MAX_LEN + 1), size - offset);
+			bool   const write  = random() & 1;
+
+			if (write)
+				for (size_t j = 0; j < len; j++)
+					buf[j] = (char)random();
+
+			/* split the access at block boundaries as the VFS handle does */
+			for (size_t done = 0; done < len; ) {
+
+				size_t          const pos   = offset + done;
+				Block::sector_t const nr    = pos / BLOCK_SIZE;
+				size_t          const local = pos % BLOCK_SIZE;
+				size_t          const n     = min(len - done, BLOCK_SIZE - local);
+				Block::sector_t const count = (offset + len - 1)/BLOCK_SIZE - nr + 1;
+
+				bool const ok = write
+				              ? cache.write(nr, local, buf + done, n, io)
+				              : cache.read(nr, count, local, buf + done, n, io);
+
+				_check("random access", ok);
+				done += n;
+			}
+
+			if (write)
+				memcpy(reference.data + offset, buf, len);
+			else
+				_check("random read", memcmp(reference.data + offset, buf, len) == 0);
+
+			if (i % 1000 == 999) {
+				_check("random sync", cache.sync(io));
+				_check("device content after sync",
+				       memcmp(reference.data, device.data, size) == 0);
+			}
+		}
+
+		log("random accesses: ", device.reads, " reads, ", device.writes, " writes, "
+		    "avg ", device.written_blocks/max(device.writes, 1UL), " blocks per write");
+
+		destroy(_heap, &reference);
+		destroy(_heap, &device);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- VFS block cache test ---");
+
+		_test_partial_write();
+		_test_merged_runs();
+		_test_eviction();
+		_test_failing_write_back();
+		_test_random();
+
+		if (_ok)
+			log("--- VFS block cache test finished ---");
+		else
+			error("VFS block cache test failed");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,4 @@
+TARGET  = test-vfs_block_cache
+SRC_CC  = main.cc
+LIBS    = base
+INC_DIR += $(REP_DIR)/src/lib/vfs
@@ -0,0 +1,167 @@
+/*
+ * \brief  Benchmark for the traversal of large XML documents
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * The benchmark generates a state report as produced by init for a large
+ * number of children and traverses it in ways typical for the consumers
+ * of such reports, once using plain 'Xml_node' objects and once using an
+ * 'Xml_index' of the report. The results of both traversals must match.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+
+	typedef String<32> Name;
+}
+
+
+struct Test::Main
+{
+	enum { NUM_CHILDREN = 256, ROUNDS = 4, REPORT_SIZE = 1024*1024 };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_ram_dataspace _report { _env.ram(), _env.rm(), REPORT_SIZE };
+
+	static Name _child_name(unsigned i) { return Name("child_", i); }
+
+	void _generate_report()
+	{
+		Xml_generator xml(_report.local_addr<char>(), REPORT_SIZE, "state", [&] () {
+			xml.attribute("version", "benchmark");
+
+			for (unsigned i = 0; i < NUM_CHILDREN; i++) {
+				xml.node("child", [&] () {
+					xml.attribute("name",   _child_name(i));
+					xml.attribute("binary", "dummy");
+					xml.attribute("id",     i + 1);
+					xml.node("ram", [&] () {
+						xml.attribute("assigned", "1M");
+						xml.attribute("quota",    (1 + i % 16)*1024*1024);
+						xml.attribute("used",     (1 + i % 7)*4096);
+						xml.attribute("avail",    1024*1024 - (1 + i % 7)*4096);
+					});
+					xml.node("caps", [&] () {
+						xml.attribute("assigned", 100);
+						xml.attribute("quota",    100);
+						xml.attribute("used",     i % 50);
+						xml.attribute("avail",    100 - i % 50);
+					});
+					xml.node("requested", [&] () {
+						for (unsigned j = 0; j < 4; j++)
+							xml.node("session", [&] () {
+								xml.attribute("service", "ROM");
+								xml.attribute("label",   Name("rom_", j));
+								xml.attribute("state",   "CAP_HANDED_OUT");
+							});
+					});
+				});
+			}
+		});
+	}
+
+	/**
+	 * Look up each child by name and sum up its RAM quota
+	 */
+	static unsigned long _lookup_by_name(Xml_node state)
+	{
+		unsigned long sum = 0;
+		for (unsigned i = 0; i < NUM_CHILDREN; i++) {
+			Name const name = _child_name(i);
+			state.for_each_sub_node("child", [&] (Xml_node child) {
+				if (child.attribute_value("name", Name()) == name)
+					sum += child.sub_node("ram").attribute_value("quota", 0UL);
+			});
+		}
+		return sum;
+	}
+
+	/**
+	 * Access each child by index and count its sessions
+	 */
+	static unsigned long _access_by_index(Xml_node state)
+	{
+		unsigned long sum = 0;
+		for (unsigned i = 0; i < state.num_sub_nodes(); i++)
+			state.sub_node(i).sub_node("requested").for_each_sub_node("session",
+				[&] (Xml_node) { sum++; });
+		return sum;
+	}
+
+	template <typename FN>
+	unsigned long _measure(char const *what, FN const &fn)
+	{
+		unsigned long const start = _timer.elapsed_ms();
+		unsigned long result = 0;
+		for (unsigned i = 0; i < ROUNDS; i++)
+			result = fn();
+		log(what, ": ", (_timer.elapsed_ms() - start)/ROUNDS, " ms");
+		return result;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML traversal benchmark ---");
+
+		_generate_report();
+
+		Xml_node const state(_report.local_addr<char>());
+
+		log("report of ", state.size(), " bytes, ",
+		    state.num_sub_nodes(), " children");
+
+		unsigned long const plain_lookup = _measure("plain lookup by name",
+			[&] () { return _lookup_by_name(state); });
+
+		unsigned long const plain_access = _measure("plain access by index",
+			[&] () { return _access_by_index(state); });
+
+		_measure("index creation", [&] () {
+			Xml_index index(_heap, state);
+			return index.num_nodes(); });
+
+		Xml_index index(_heap, state);
+
+		unsigned long const indexed_lookup = _measure("indexed lookup by name",
+			[&] () { return _lookup_by_name(index.xml()); });
+
+		unsigned long const indexed_access = _measure("indexed access by index",
+			[&] () { return _access_by_index(index.xml()); });
+
+		if (plain_lookup != indexed_lookup || plain_access != indexed_access) {
+			error("results of plain and indexed traversal differ");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- XML traversal benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -116,6 +116,8 @@ class Noux::Child : public Rpc_object<Session>,
 
 		User_info const &_user_info;
 
+		size_t const _pipe_buffer_size;
+
 		Parent_exit       *_parent_exit;
 		Kill_broadcaster  &_kill_broadcaster;
 		Timeout_scheduler &_timeout_scheduler;
@@ -136,6 +138,26 @@ class Noux::Child : public Rpc_object<Session>,
 		Signal_handler<Child> _destruct_handler {
 			_env.ep(), *this, &Child::_handle_destruct };
 
+		bool _cow_failed = false;
+
+		/*
+		 * A copy-on-write fault of the process could not be resolved. The
+		 * process is blocked forever and is therefore terminated.
+		 */
+		void _handle_cow_failure()
+		{
+			if (_cow_failed)
+				return;
+
+			_cow_failed = true;
+
+			error(_name, ": terminating process after unresolvable copy-on-write fault");
+			_child_policy.exit(1);
+		}
+
+		Signal_handler<Child> _cow_failure_handler {
+			_env.ep(), *this, &Child::_handle_cow_failure };
+
 		Allocator &_heap;
 
 		/**
@@ -302,6 +324,8 @@ class Noux::Child : public Rpc_object<Session>,
 		/**
 		 * Constructor
 		 *
+		 * \param pipe_buffer_size  buffer size of pipes created by the
+		 *                          process
 		 * \param forked  false if the child is spawned directly from
 		 *                an executable binary (i.e., the init process,
 		 *                or children created via execve, or
@@ -317,6 +341,7 @@ class Noux::Child : public Rpc_object<Session>,
 		Child(Child_policy::Name const &name,
 		      Verbose            const &verbose,
 		      User_info          const &user_info,
+		      size_t                    pipe_buffer_size,
 		      Parent_exit              *parent_exit,
 		      Kill_broadcaster         &kill_broadcaster,
 		      Timeout_scheduler        &timeout_scheduler,
@@ -340,6 +365,7 @@ class Noux::Child : public Rpc_object<Session>,
 			_name(name),
 			_verbose(verbose),
 			_user_info(user_info),
+			_pipe_buffer_size(pipe_buffer_size),
 			_parent_exit(parent_exit),
 			_kill_broadcaster(kill_broadcaster),
 			_timeout_scheduler(timeout_scheduler),
@@ -371,6 +397,8 @@ class Noux::Child : public Rpc_object<Session>,
 			if (_verbose.enabled())
 				_args.dump();
 
+			_pd.cow_failure_sigh(_cow_failure_handler);
+
 			if (!_child.main_thread_cap().valid()) {
 				_destruct();
 				throw Insufficient_memory();
@@ -519,6 +547,7 @@ class Noux::Child : public Rpc_object<Session>,
 			Child *child = new (_heap) Child(filename,
 			                                 _verbose,
 			                                 _user_info,
+			                                 _pipe_buffer_size,
 			                                 _parent_exit,
 			                                 _kill_broadcaster,
 			                                 _timeout_scheduler,
@@ -0,0 +1,499 @@
+/*
+ * \brief  Copy-on-write RAM dataspace shared by forked Noux processes
+ * \author Genode Labs
+ * \date   2026-10-19
+ *
+ * When a process forks, its RAM dataspaces are not copied eagerly. Instead,
+ * the content is frozen in the form of read-only snapshots that are shared
+ * by the parent and the child. Each process accesses the content via a
+ * managed dataspace of its own. The managed dataspace is composed of
+ * extents, each referring to a range of a snapshot. A write access to a
+ * read-only extent is reflected as page fault to Noux, which replaces the
+ * naturally aligned granule of 'COPY_GRANULE' bytes around the faulting
+ * page by a private copy. The extents are indexed by an AVL tree.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NOUX__COW_DATASPACE_H_
+#define _NOUX__COW_DATASPACE_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/signal.h>
+#include <base/log.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <util/avl_tree.h>
+#include <util/string.h>
+
+namespace Noux {
+	class Cow_snapshot;
+	class Cow_dataspace;
+	using namespace Genode;
+}
+
+
+/**
+ * Immutable RAM dataspace shared by one or more copy-on-write dataspaces
+ */
+class Noux::Cow_snapshot : Noncopyable
+{
+	private:
+
+		Allocator                &_alloc;
+		Ram_allocator            &_ram;
+		Ram_dataspace_capability  _ds;
+
+		/* number of extents referring to the snapshot */
+		unsigned _users = 0;
+
+	public:
+
+		Cow_snapshot(Allocator &alloc, Ram_allocator &ram,
+		             Ram_dataspace_capability ds)
+		: _alloc(alloc), _ram(ram), _ds(ds) { }
+
+		~Cow_snapshot() { _ram.free(_ds); }
+
+		Allocator               &alloc()     { return _alloc; }
+		Ram_dataspace_capability ds()  const { return _ds; }
+
+		/**
+		 * Return true if the snapshot is referenced by a single extent
+		 *
+		 * In this case, the snapshot can be written to directly.
+		 */
+		bool exclusive() const { return _users == 1; }
+
+		void acquire() { _users++; }
+
+		/**
+		 * Drop reference
+		 *
+		 * \return true if the last reference was dropped
+		 */
+		bool release() { return --_users == 0; }
+};
+
+
+class Noux::Cow_dataspace : Noncopyable
+{
+	private:
+
+		enum { PAGE_SIZE = 4096, COPY_GRANULE = 16*PAGE_SIZE };
+
+		/**
+		 * Range of the managed dataspace backed by a snapshot
+		 */
+		struct Extent : Avl_node<Extent>
+		{
+			addr_t        offset;
+			size_t        size;
+			Cow_snapshot &snapshot;
+			addr_t        snapshot_offset;
+			bool          writeable;
+
+			Extent(addr_t offset, size_t size, Cow_snapshot &snapshot,
+			       addr_t snapshot_offset, bool writeable)
+			:
+				offset(offset), size(size), snapshot(snapshot),
+				snapshot_offset(snapshot_offset), writeable(writeable)
+			{ }
+
+			addr_t end() const { return offset + size; }
+
+			bool contains(addr_t addr) const {
+				return addr >= offset && addr < end(); }
+
+			bool higher(Extent *e) { return e->offset > offset; }
+		};
+
+		/*
+		 * The state of all copy-on-write dataspaces is protected by a single
+		 * lock because a fork as well as the resolution of a fault affects
+		 * the dataspaces of several processes. Faults are handled by the
+		 * initial entrypoint whereas forks and pokes are executed by the
+		 * entrypoints of the processes.
+		 */
+		static Lock &_lock()
+		{
+			static Lock lock;
+			return lock;
+		}
+
+		Env           &_env;
+		Allocator     &_alloc;
+		Rm_connection &_rm_connection;
+		size_t const   _size;
+		bool           _executable;
+
+		static Capability<Region_map> _create(Rm_connection &rm, size_t size)
+		{
+			for (;;) {
+				try { return rm.create(size); }
+				catch (Out_of_ram)  { rm.upgrade_ram(8*1024); }
+				catch (Out_of_caps) { rm.upgrade_caps(2); }
+			}
+		}
+
+		Region_map_client          _rm { _create(_rm_connection, _size) };
+		Dataspace_capability const _ds { _rm.dataspace() };
+
+		Avl_tree<Extent> _extents { };
+
+		/* signal handler informed about unresolvable faults */
+		Signal_context_capability _failure_sigh { };
+
+		Signal_handler<Cow_dataspace> _fault_handler {
+			_env.ep(), *this, &Cow_dataspace::_handle_fault };
+
+		void _attach(Extent const &extent)
+		{
+			for (;;) {
+				try {
+					_rm.attach(extent.snapshot.ds(), extent.size,
+					           extent.snapshot_offset, true, extent.offset,
+					           _executable, extent.writeable);
+					return;
+				}
+				catch (Out_of_ram)  { _rm_connection.upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm_connection.upgrade_caps(2); }
+			}
+		}
+
+		void _detach(Extent const &extent) { _rm.detach(extent.offset); }
+
+		/**
+		 * Change access rights of extent
+		 *
+		 * Detaching the extent flushes all existing mappings. Re-attaching
+		 * the extent wakes up the threads that faulted within its range.
+		 */
+		void _reattach(Extent &extent, bool writeable)
+		{
+			_detach(extent);
+			extent.writeable = writeable;
+			_attach(extent);
+		}
+
+		Extent *_lookup(addr_t offset) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = _extents.first(); e; ) {
+				if (e->offset <= offset) {
+					result = e;
+					e = e->child(Extent::RIGHT);
+				} else {
+					e = e->child(Extent::LEFT);
+				}
+			}
+			return (result && result->contains(offset)) ? result : nullptr;
+		}
+
+		/**
+		 * Call 'fn' for each extent in the order of the offsets
+		 */
+		template <typename FN>
+		void _for_each_extent(FN const &fn)
+		{
+			for (Extent *e = _lookup(0); e; e = _lookup(e->end()))
+				fn(*e);
+		}
+
+		static void _release(Cow_snapshot &snapshot)
+		{
+			if (!snapshot.release())
+				return;
+
+			Allocator &alloc = snapshot.alloc();
+			destroy(alloc, &snapshot);
+		}
+
+		/**
+		 * Create private snapshot holding a copy of 'size' bytes of 'src'
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Cow_snapshot &_copy(Cow_snapshot &src, addr_t src_offset, size_t size)
+		{
+			Ram_dataspace_capability ds = _env.ram().alloc(size);
+
+			char *dst_ptr = nullptr, *src_ptr = nullptr;
+			try {
+				dst_ptr = _env.rm().attach(ds);
+				src_ptr = _env.rm().attach(src.ds(), size, src_offset);
+
+				memcpy(dst_ptr, src_ptr, size);
+
+				_env.rm().detach(src_ptr); src_ptr = nullptr;
+				_env.rm().detach(dst_ptr); dst_ptr = nullptr;
+
+				Cow_snapshot &snapshot = *new (_alloc) Cow_snapshot(_alloc, _env.ram(), ds);
+				snapshot.acquire();
+				return snapshot;
+			}
+			catch (...) {
+				if (src_ptr) _env.rm().detach(src_ptr);
+				if (dst_ptr) _env.rm().detach(dst_ptr);
+				_env.ram().free(ds);
+				throw;
+			}
+		}
+
+		/**
+		 * Make page at 'offset' within 'extent' writeable
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void _make_writeable(Extent &extent, addr_t const offset)
+		{
+			Cow_snapshot &snapshot = extent.snapshot;
+
+			/*
+			 * The snapshot is no longer shared with other extents, e.g.,
+			 * because the forked child has exited already.
+			 */
+			if (snapshot.exclusive()) {
+				_reattach(extent, true);
+				return;
+			}
+
+			/* copy the granule around the page, clipped to the extent */
+			addr_t const granule = offset & ~((addr_t)COPY_GRANULE - 1);
+			addr_t const start   = max(extent.offset, granule);
+			addr_t const end     = min(extent.end(), granule + COPY_GRANULE);
+
+			Cow_snapshot &copy =
+				_copy(snapshot, extent.snapshot_offset + start - extent.offset,
+				      end - start);
+
+			/* allocate the new extents before changing the layout */
+			Extent *copied = nullptr, *right = nullptr;
+			try {
+				copied = new (_alloc) Extent(start, end - start, copy, 0, true);
+
+				if (end < extent.end())
+					right = new (_alloc)
+						Extent(end, extent.end() - end, snapshot,
+						       extent.snapshot_offset + end - extent.offset, false);
+			}
+			catch (...) {
+				if (copied) destroy(_alloc, copied);
+				_release(copy);
+				throw;
+			}
+
+			_detach(extent);
+
+			/* split extent into the part left of the copy, the copy, and the rest */
+			if (right) {
+				snapshot.acquire();
+				_extents.insert(right);
+				_attach(*right);
+			}
+
+			_extents.insert(copied);
+			_attach(*copied);
+
+			if (start > extent.offset) {
+				extent.size = start - extent.offset;
+				_attach(extent);
+			} else {
+				_extents.remove(&extent);
+				destroy(_alloc, &extent);
+				_release(snapshot);
+			}
+		}
+
+		void _fail()
+		{
+			if (_failure_sigh.valid())
+				Signal_transmitter(_failure_sigh).submit();
+		}
+
+		void _handle_fault()
+		{
+			Lock::Guard guard(_lock());
+
+			/*
+			 * Several threads may have faulted before the signal got
+			 * delivered. Core reports one fault at a time and removes the
+			 * faulter as soon as its fault got resolved by an attachment.
+			 */
+			for (;;) {
+				Region_map::State const state = _rm.state();
+
+				if (state.type == Region_map::State::READY)
+					return;
+
+				addr_t const offset = state.addr & ~((addr_t)PAGE_SIZE - 1);
+
+				Extent * const extent = _lookup(offset);
+
+				if (!extent || state.type != Region_map::State::WRITE_FAULT
+				 || extent->writeable) {
+					error("unresolvable fault at ", Hex(state.addr),
+					      " of copy-on-write dataspace");
+					return;
+				}
+
+				/*
+				 * Noux requests RAM and capabilities from its parent on
+				 * demand. If the parent denies the upgrade, the faulting
+				 * process cannot proceed and is terminated by the owner of
+				 * the failure signal handler.
+				 */
+				try { _make_writeable(*extent, offset); }
+				catch (Out_of_ram) {
+					error("out of memory while resolving copy-on-write fault");
+					_fail();
+					return;
+				}
+				catch (Out_of_caps) {
+					error("out of capabilities while resolving copy-on-write fault");
+					_fail();
+					return;
+				}
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor for sharing the content of a RAM dataspace
+		 *
+		 * \param snapshot  snapshot wrapping the original RAM dataspace
+		 */
+		Cow_dataspace(Env &env, Allocator &alloc, Rm_connection &rm_connection,
+		              Cow_snapshot &snapshot, size_t size)
+		:
+			_env(env), _alloc(alloc), _rm_connection(rm_connection),
+			_size(size), _executable(false)
+		{
+			_rm.fault_handler(_fault_handler);
+
+			Lock::Guard guard(_lock());
+
+			Extent &extent = *new (_alloc) Extent(0, _size, snapshot, 0, true);
+			snapshot.acquire();
+			_extents.insert(&extent);
+			_attach(extent);
+		}
+
+		/**
+		 * Constructor for the copy of 'parent' in a forked process
+		 *
+		 * The current content of 'parent' is frozen and shared by both
+		 * dataspaces.
+		 */
+		Cow_dataspace(Env &env, Allocator &alloc, Rm_connection &rm_connection,
+		              Cow_dataspace &parent)
+		:
+			_env(env), _alloc(alloc), _rm_connection(rm_connection),
+			_size(parent._size), _executable(parent._executable)
+		{
+			_rm.fault_handler(_fault_handler);
+
+			Lock::Guard guard(_lock());
+
+			parent._for_each_extent([&] (Extent &p) {
+
+				/* revoke write access from the parent */
+				if (p.writeable)
+					parent._reattach(p, false);
+
+				Extent &extent = *new (_alloc)
+					Extent(p.offset, p.size, p.snapshot, p.snapshot_offset, false);
+
+				p.snapshot.acquire();
+				_extents.insert(&extent);
+				_attach(extent);
+			});
+		}
+
+		~Cow_dataspace()
+		{
+			Lock::Guard guard(_lock());
+
+			while (Extent *extent = _extents.first()) {
+				Cow_snapshot &snapshot = extent->snapshot;
+
+				_detach(*extent);
+				_extents.remove(extent);
+				destroy(_alloc, extent);
+
+				_release(snapshot);
+			}
+
+			_rm_connection.destroy(_rm.rpc_cap());
+		}
+
+		/**
+		 * Return managed dataspace to be attached by the process
+		 */
+		Dataspace_capability ds() const { return _ds; }
+
+		/**
+		 * Register signal handler informed about faults that could not be
+		 * resolved because of exhausted resources
+		 */
+		void failure_sigh(Signal_context_capability sigh) { _failure_sigh = sigh; }
+
+		/**
+		 * Permit the execution of the dataspace content
+		 */
+		void make_executable()
+		{
+			Lock::Guard guard(_lock());
+
+			if (_executable)
+				return;
+
+			_executable = true;
+			_for_each_extent([&] (Extent &e) { _reattach(e, e.writeable); });
+		}
+
+		/**
+		 * Write raw byte sequence into dataspace
+		 */
+		void write(addr_t offset, char const *src, size_t len)
+		{
+			Lock::Guard guard(_lock());
+
+			while (len > 0) {
+
+				addr_t const page = offset & ~((addr_t)PAGE_SIZE - 1);
+				size_t const n    = min(len, (size_t)(page + PAGE_SIZE - offset));
+
+				Extent *extent = _lookup(page);
+				if (extent && !extent->writeable) {
+					_make_writeable(*extent, page);
+					extent = _lookup(page);
+				}
+
+				if (!extent) {
+					error("write beyond copy-on-write dataspace boundary");
+					return;
+				}
+
+				char * const ptr =
+					_env.rm().attach(extent->snapshot.ds(), PAGE_SIZE,
+					                 extent->snapshot_offset + page - extent->offset);
+
+				memcpy(ptr + offset - page, src, n);
+				_env.rm().detach(ptr);
+
+				offset += n; src += n; len -= n;
+			}
+		}
+};
+
+#endif /* _NOUX__COW_DATASPACE_H_ */
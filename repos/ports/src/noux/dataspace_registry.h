@@ -32,6 +32,11 @@ namespace Noux {
 struct Noux::Dataspace_user : List<Dataspace_user>::Element
 {
 	virtual void dissolve(Dataspace_info &ds) = 0;
+
+	/**
+	 * Attach dataspace anew, e.g., after it became copy-on-write
+	 */
+	virtual void remap(Dataspace_info &ds) = 0;
 };
 
 
@@ -86,6 +91,23 @@ class Noux::Dataspace_info : public Object_pool<Dataspace_info>::Entry
 			}
 		}
 
+		void remap_users()
+		{
+			Lock::Guard guard(_users_lock);
+			for (Dataspace_user *user = _users.first(); user; user = user->next())
+				user->remap(*this);
+		}
+
+		/**
+		 * Return dataspace to attach in place of the dataspace
+		 *
+		 * The returned dataspace differs from 'ds_cap' for dataspaces
+		 * shared copy-on-write with other processes.
+		 *
+		 * \param executable  true if the dataspace is attached executable
+		 */
+		virtual Dataspace_capability attach_cap(bool executable) { return _ds_cap; }
+
 		/**
 		 * Create shadow copy of dataspace
 		 *
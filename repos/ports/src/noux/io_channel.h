@@ -85,6 +85,35 @@ class Noux::Io_channel : public Reference_counter
 		virtual bool     ioctl(Sysio &sysio)                 { return false; }
 		virtual bool     lseek(Sysio &sysio)                 { return false; }
 
+		/**
+		 * Read request of a process that blocks on the channel
+		 *
+		 * While the request is announced, a channel may deliver data
+		 * directly into the sysio buffer of the blocking process.
+		 */
+		struct Read_request
+		{
+			Sysio &sysio;
+
+			size_t count = 0;   /* number of bytes delivered */
+
+			Read_request(Sysio &sysio) : sysio(sysio) { }
+
+			size_t deliver(char const *src, size_t len)
+			{
+				size_t const capacity =
+					min(sysio.read_in.count, sizeof(sysio.read_out.chunk));
+
+				size_t const n = min(len, capacity - count);
+				memcpy(sysio.read_out.chunk + count, src, n);
+				count += n;
+				return n;
+			}
+		};
+
+		virtual void announce_read(Read_request &) { }
+		virtual void withdraw_read(Read_request &) { }
+
 		/**
 		 * Return true if an unblocking condition of the channel is satisfied
 		 *
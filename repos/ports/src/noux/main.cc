@@ -22,6 +22,7 @@
 #include <noux_session/sysio.h>
 #include <vfs_io_channel.h>
 #include <terminal_io_channel.h>
+#include <pipe_io_channel.h>
 #include <user_info.h>
 #include <io_receptor_registry.h>
 #include <destruct_queue.h>
@@ -181,6 +182,10 @@ struct Noux::Main
 
 	Verbose _verbose { _config.xml() };
 
+	size_t const _pipe_buffer_size =
+		_config.xml().attribute_value("pipe_buffer_size",
+		                              Number_of_bytes((size_t)Pipe::DEFAULT_BUFFER_SIZE));
+
 	/**
 	 * Return name of init process as specified in the config
 	 */
@@ -277,6 +282,7 @@ struct Noux::Main
 	Noux::Child _init_child { _name_of_init_process(),
 	                          _verbose,
 	                          _user_info,
+	                          _pipe_buffer_size,
 	                          0,
 	                          _kill_broadcaster,
 	                          _timeout_scheduler,
@@ -10,7 +10,7 @@
  * Furthermore, the custom implementation is needed to get hold of the RAM
  * dataspaces allocated by each Noux process. When forking a process, the
  * acquired information (in the form of 'Ram_dataspace_info' objects) is used
- * to create a shadow copy of the forking address space.
+ * to share the RAM dataspaces copy-on-write with the new process.
  */
 
 /*
@@ -27,10 +27,13 @@
 #include <pd_session/connection.h>
 #include <base/rpc_server.h>
 #include <base/env.h>
+#include <rm_session/connection.h>
+#include <util/reconstructible.h>
 
 /* Noux includes */
 #include <region_map_component.h>
 #include <dataspace_registry.h>
+#include <cow_dataspace.h>
 
 namespace Noux {
 	struct Ram_dataspace_info;
@@ -42,36 +45,36 @@ namespace Noux {
 struct Noux::Ram_dataspace_info : Dataspace_info,
                                   List<Ram_dataspace_info>::Element
 {
+	/**
+	 * Backing store of a dataspace shared with other processes
+	 *
+	 * Once constructed, the original RAM dataspace is owned by the
+	 * copy-on-write dataspace and must not be freed directly.
+	 */
+	Constructible<Cow_dataspace> cow { };
+
 	Ram_dataspace_info(Ram_dataspace_capability ds_cap)
 	: Dataspace_info(ds_cap) { }
 
-	Dataspace_capability fork(Ram_allocator      &ram,
-	                          Region_map         &local_rm,
-	                          Allocator          &alloc,
-	                          Dataspace_registry &ds_registry,
-	                          Rpc_entrypoint     &) override
+	/**
+	 * The dataspace is shared with the forked process by
+	 * 'Pd_session_component::replay' under the same capability.
+	 */
+	Dataspace_capability fork(Ram_allocator &, Region_map &, Allocator &,
+	                          Dataspace_registry &, Rpc_entrypoint &) override
 	{
-		size_t const size = Dataspace_client(ds_cap()).size();
-		Ram_dataspace_capability dst_ds_cap;
-
-		try {
-			dst_ds_cap = ram.alloc(size);
-
-			Attached_dataspace src_ds(local_rm, ds_cap());
-			Attached_dataspace dst_ds(local_rm, dst_ds_cap);
-			memcpy(dst_ds.local_addr<char>(), src_ds.local_addr<char>(), size);
-
-			ds_registry.insert(new (alloc) Ram_dataspace_info(dst_ds_cap));
-			return dst_ds_cap;
+		return ds_cap();
+	}
 
-		} catch (...) {
-			error("fork of RAM dataspace failed");
+	Dataspace_capability attach_cap(bool executable) override
+	{
+		if (!cow.constructed())
+			return ds_cap();
 
-			if (dst_ds_cap.valid())
-				ram.free(dst_ds_cap);
+		if (executable)
+			cow->make_executable();
 
-			return Dataspace_capability();
-		}
+		return cow->ds();
 	}
 
 	void poke(Region_map &rm, addr_t dst_offset, char const *src, size_t len) override
@@ -83,6 +86,11 @@ struct Noux::Ram_dataspace_info : Dataspace_info,
 			return;
 		}
 
+		if (cow.constructed()) {
+			cow->write(dst_offset, src, len);
+			return;
+		}
+
 		try {
 			Attached_dataspace ds(rm, ds_cap());
 			memcpy(ds.local_addr<char>() + dst_offset, src, len);
@@ -95,6 +103,8 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 {
 	private:
 
+		Env &_env;
+
 		Rpc_entrypoint &_ep;
 
 		Pd_connection _pd;
@@ -115,6 +125,63 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 
 		Dataspace_registry &_ds_registry;
 
+		/*
+		 * Session for creating the managed dataspaces of copy-on-write
+		 * RAM, constructed on the first fork
+		 */
+		Constructible<Rm_connection> _cow_rm_connection { };
+
+		/* handler of copy-on-write faults that could not be resolved */
+		Signal_context_capability _cow_failure_sigh { };
+
+		Rm_connection &_cow_rm()
+		{
+			if (!_cow_rm_connection.constructed())
+				_cow_rm_connection.construct(_env);
+
+			return *_cow_rm_connection;
+		}
+
+		/**
+		 * Return copy-on-write dataspace of RAM dataspace
+		 *
+		 * On the first call, the existing attachments of the RAM dataspace
+		 * are replaced by the attachment of the copy-on-write dataspace.
+		 */
+		Cow_dataspace &_cow(Ram_dataspace_info &info)
+		{
+			if (info.cow.constructed())
+				return *info.cow;
+
+			Ram_dataspace_capability const ds =
+				static_cap_cast<Ram_dataspace>(info.ds_cap());
+
+			Cow_snapshot &snapshot = *new (_alloc) Cow_snapshot(_alloc, _ram, ds);
+
+			info.cow.construct(_env, _alloc, _cow_rm(), snapshot, info.size());
+			info.cow->failure_sigh(_cow_failure_sigh);
+			info.remap_users();
+
+			return *info.cow;
+		}
+
+		/**
+		 * Adopt RAM dataspace of forking process as copy-on-write copy
+		 */
+		void _adopt(Ram_dataspace_info &src, Cow_dataspace &src_cow)
+		{
+			Ram_dataspace_info *info = new (_alloc)
+				Ram_dataspace_info(static_cap_cast<Ram_dataspace>(src.ds_cap()));
+
+			info->cow.construct(_env, _alloc, _cow_rm(), src_cow);
+			info->cow->failure_sigh(_cow_failure_sigh);
+
+			_ds_registry.insert(info);
+			_ds_list.insert(info);
+
+			_used_ram_quota = Ram_quota { _used_ram_quota.value + info->size() };
+		}
+
 		template <typename FUNC>
 		auto _with_automatic_cap_upgrade(FUNC func) -> decltype(func())
 		{
@@ -135,7 +202,7 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 		                     Child_policy::Name const &name,
 		                     Dataspace_registry &ds_registry)
 		:
-			_ep(ep), _pd(env, name.string()), _ref_pd(env.pd()),
+			_env(env), _ep(ep), _pd(env, name.string()), _ref_pd(env.pd()),
 			_address_space(alloc, _ep, ds_registry, _pd, _pd.address_space()),
 			_stack_area   (alloc, _ep, ds_registry, _pd, _pd.stack_area()),
 			_linker_area  (alloc, _ep, ds_registry, _pd, _pd.linker_area()),
@@ -163,6 +230,12 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 
 		Pd_session_capability core_pd_cap() { return _pd.cap(); }
 
+		/**
+		 * Register handler of copy-on-write faults that could not be
+		 * resolved, e.g., because Noux ran out of RAM or capabilities
+		 */
+		void cow_failure_sigh(Signal_context_capability sigh) { _cow_failure_sigh = sigh; }
+
 		void poke(Region_map &rm, addr_t dst_addr, char const *src, size_t len)
 		{
 			_address_space.poke(rm, dst_addr, src, len);
@@ -183,6 +256,14 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 		            Dataspace_registry   &ds_registry,
 		            Rpc_entrypoint       &ep)
 		{
+			/*
+			 * Share RAM dataspaces with the new protection domain before
+			 * replaying the attachments, which refer to the shared
+			 * dataspaces by their original capabilities.
+			 */
+			for (Ram_dataspace_info *info = _ds_list.first(); info; info = info->next())
+				dst_pd._adopt(*info, _cow(*info));
+
 			/* replay region map into new protection domain */
 			_stack_area   .replay(dst_pd, dst_pd.stack_area_region_map(),    local_rm, alloc, ds_registry, ep);
 			_linker_area  .replay(dst_pd, dst_pd.linker_area_region_map(),   local_rm, alloc, ds_registry, ep);
@@ -297,7 +378,10 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 				_ds_registry.remove(ds_info);
 				ds_info->dissolve_users();
 				_ds_list.remove(ds_info);
-				_ram.free(ds_cap);
+
+				/* shared backing store is released by 'Cow_dataspace' */
+				if (!ds_info->cow.constructed())
+					_ram.free(ds_cap);
 
 				_used_ram_quota = Ram_quota { _used_ram_quota.value - ds_size };
 			};
@@ -26,40 +26,43 @@ namespace Noux {
 
 class Noux::Pipe : public Reference_counter
 {
+	public:
+
+		enum { DEFAULT_BUFFER_SIZE = 64*1024, MIN_BUFFER_SIZE = 4096 };
+
 	private:
 
 		Lock mutable _lock;
 
-		enum { BUFFER_SIZE = 4096 };
-		char _buffer[BUFFER_SIZE];
+		Allocator &_alloc;
 
-		unsigned _read_offset;
-		unsigned _write_offset;
+		size_t const _size;
+		char * const _buffer;
+
+		size_t _read_offset = 0;
+		size_t _fill        = 0;
 
 		Signal_context_capability _read_ready_sigh;
 		Signal_context_capability _write_ready_sigh;
 
-		bool _writer_is_gone;
+		bool _writer_is_gone = false;
 
-		/**
-		 * Return space available in the buffer for writing, in bytes
+		/*
+		 * Request of a reader that blocks on the empty pipe
+		 *
+		 * While a reader is blocking, written data is copied directly into
+		 * the sysio buffer of the reader instead of being staged in the
+		 * pipe buffer.
 		 */
-		size_t _avail_buffer_space() const
-		{
-			if (_read_offset < _write_offset)
-				return (BUFFER_SIZE - _write_offset) + _read_offset - 1;
+		Io_channel::Read_request *_read_request = nullptr;
 
-			if (_read_offset > _write_offset)
-				return _read_offset - _write_offset - 1;
+		size_t _avail_buffer_space() const { return _size - _fill; }
 
-			/* _read_offset == _write_offset */
-			return BUFFER_SIZE - 1;
-		}
-
-		bool _any_space_avail_for_writing() const
-		{
-			return _avail_buffer_space() > 0;;
-		}
+		/*
+		 * A blocked writer is not woken up before a quarter of the buffer
+		 * became available, which lets it write in large portions.
+		 */
+		size_t _write_ready_threshold() const { return _size/4; }
 
 		void _wake_up_reader()
 		{
@@ -75,12 +78,21 @@ class Noux::Pipe : public Reference_counter
 
 	public:
 
-		Pipe()
-		: _read_offset(0), _write_offset(0), _writer_is_gone(false) { }
+		/**
+		 * Constructor
+		 *
+		 * \param size  size of the pipe buffer in bytes
+		 */
+		Pipe(Allocator &alloc, size_t size)
+		:
+			_alloc(alloc), _size(max(size, (size_t)MIN_BUFFER_SIZE)),
+			_buffer((char *)_alloc.alloc(_size))
+		{ }
 
 		~Pipe()
 		{
 			Lock::Guard guard(_lock);
+			_alloc.free(_buffer, _size);
 		}
 
 		void writer_close()
@@ -107,50 +119,55 @@ class Noux::Pipe : public Reference_counter
 		bool any_space_avail_for_writing() const
 		{
 			Lock::Guard guard(_lock);
-			return _any_space_avail_for_writing();
+			return _avail_buffer_space() > 0;
 		}
 
 		bool data_avail_for_reading() const
 		{
 			Lock::Guard guard(_lock);
 
-			return _read_offset != _write_offset;
+			return _fill > 0 || (_read_request && _read_request->count > 0);
 		}
 
-		size_t read(char *dst, size_t dst_len)
+		/**
+		 * Register reader that is about to block on the pipe
+		 */
+		void announce_read(Io_channel::Read_request &request)
+		{
+			Lock::Guard guard(_lock);
+
+			if (!_read_request && _fill == 0)
+				_read_request = &request;
+		}
+
+		void withdraw_read(Io_channel::Read_request &request)
 		{
 			Lock::Guard guard(_lock);
 
-			if (_read_offset < _write_offset) {
+			if (_read_request == &request)
+				_read_request = nullptr;
+		}
 
-				size_t len = min(dst_len, _write_offset - _read_offset);
-				memcpy(dst, &_buffer[_read_offset], len);
+		size_t read(char *dst, size_t dst_len)
+		{
+			Lock::Guard guard(_lock);
 
-				_read_offset += len;
-				_wake_up_writer();
+			size_t const avail_before = _avail_buffer_space();
 
-				return len;
-			}
+			size_t const len       = min(dst_len, _fill);
+			size_t const upper_len = min(len, _size - _read_offset);
 
-			if (_read_offset > _write_offset) {
+			memcpy(dst, _buffer + _read_offset, upper_len);
+			memcpy(dst + upper_len, _buffer, len - upper_len);
 
-				size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
-				memcpy(dst, &_buffer[_read_offset], upper_len);
+			_fill       -= len;
+			_read_offset = _fill ? (_read_offset + len) % _size : 0;
 
-				size_t const lower_len = min(dst_len - upper_len, _write_offset);
-				if (lower_len) {
-					memcpy(dst + upper_len, &_buffer[0], lower_len);
-					_read_offset = lower_len;
-				} else {
-					_read_offset += upper_len;
-				}
+			if (avail_before < _write_ready_threshold()
+			 && _avail_buffer_space() >= _write_ready_threshold())
 				_wake_up_writer();
 
-				return upper_len + lower_len;
-			}
-
-			/* _read_offset == _write_offset */
-			return 0;
+			return len;
 		}
 
 		/**
@@ -158,47 +175,39 @@ class Noux::Pipe : public Reference_counter
 		 *
 		 * \return number of written bytes (may be less than 'len')
 		 */
-		size_t write(char *src, size_t len)
+		size_t write(char const *src, size_t len)
 		{
 			Lock::Guard guard(_lock);
 
-			/* trim write request to the available buffer space */
-			size_t const trimmed_len = min(len, _avail_buffer_space());
-
-			/*
-			 * Remember pipe state prior writing to see whether a reader
-			 * must be unblocked after writing.
-			 */
-			bool const pipe_was_empty = (_read_offset == _write_offset);
+			bool const pipe_was_empty = (_fill == 0);
 
-			/* write data up to the upper boundary of the pipe buffer */
-			size_t const upper_len = min(BUFFER_SIZE - _write_offset, trimmed_len);
-			memcpy(&_buffer[_write_offset], src, upper_len);
+			size_t written = 0;
 
-			_write_offset += upper_len;
+			/* hand data directly to a blocking reader */
+			if (_read_request && pipe_was_empty)
+				written = _read_request->deliver(src, len);
 
-			/*
-			 * Determine number of remaining bytes beyond the buffer boundary.
-			 * The buffer wraps. So this data will end up in the lower part
-			 * of the pipe buffer.
-			 */
-			size_t const lower_len = trimmed_len - upper_len;
+			/* trim remaining data to the available buffer space */
+			size_t const buffer_len   = min(len - written, _avail_buffer_space());
+			size_t const write_offset = (_read_offset + _fill) % _size;
+			size_t const upper_len    = min(buffer_len, _size - write_offset);
 
-			if (lower_len > 0) {
+			/* data beyond the upper buffer boundary wraps around */
+			memcpy(_buffer + write_offset, src + written, upper_len);
+			memcpy(_buffer, src + written + upper_len, buffer_len - upper_len);
 
-				/* pipe buffer wrap-around, write remaining data to the lower part */
-				memcpy(&_buffer[0], src + upper_len, lower_len);
-				_write_offset = lower_len;
-			}
+			_fill   += buffer_len;
+			written += buffer_len;
 
 			/*
-			 * Wake up reader who may block for incoming data.
+			 * Wake up reader who may block for incoming data. A reader
+			 * blocks only on an empty pipe, so subsequent writes to the
+			 * non-empty pipe need no wake-up.
 			 */
-			if (pipe_was_empty || !_any_space_avail_for_writing())
+			if (pipe_was_empty && written)
 				_wake_up_reader();
 
-			/* return number of written bytes */
-			return trimmed_len;
+			return written;
 		}
 
 		void register_write_ready_sigh(Signal_context_capability sigh)
@@ -303,6 +312,12 @@ class Noux::Pipe_source_io_channel : public Io_channel
 
 		~Pipe_source_io_channel() { _pipe->reader_close(); }
 
+		void announce_read(Read_request &request) override {
+			_pipe->announce_read(request); }
+
+		void withdraw_read(Read_request &request) override {
+			_pipe->withdraw_read(request); }
+
 		bool check_unblock(bool rd, bool wr, bool ex) const override
 		{
 			/* unblock if the writer has already closed its pipe end */
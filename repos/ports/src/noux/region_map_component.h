@@ -54,13 +54,14 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 			off_t                 offset;
 			addr_t                local_addr;
 			bool                  executable;
+			bool                  writeable;
 
 			Region(Region_map_component &rm,
 			       Dataspace_capability ds, size_t size,
-			       off_t offset, addr_t local_addr, bool exec)
+			       off_t offset, addr_t local_addr, bool exec, bool writeable)
 			:
 				rm(rm), ds(ds), size(size), offset(offset),
-				local_addr(local_addr), executable(exec)
+				local_addr(local_addr), executable(exec), writeable(writeable)
 			{ }
 
 			/**
@@ -77,6 +78,7 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 			}
 
 			inline void dissolve(Dataspace_info &ds);
+			inline void remap(Dataspace_info &ds);
 		};
 
 		Lock         _region_lock;
@@ -101,6 +103,33 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 
 		Dataspace_registry &_ds_registry;
 
+		Local_addr _core_attach(Dataspace_capability ds, size_t size,
+		                        off_t offset, bool use_local_addr,
+		                        Local_addr local_addr, bool executable,
+		                        bool writeable)
+		{
+			for (;;) {
+				try {
+					return _rm.attach(ds, size, offset, use_local_addr,
+					                  local_addr, executable, writeable);
+				}
+				catch (Out_of_ram)  { _pd.upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _pd.upgrade_caps(2); }
+			}
+		}
+
+		/**
+		 * Replace the attachment of region by the current attach dataspace
+		 */
+		void _remap(Region &region, Dataspace_info &info)
+		{
+			Dataspace_capability const ds = info.attach_cap(region.executable);
+
+			_rm.detach(region.local_addr);
+			_core_attach(ds, region.size, region.offset, true,
+			             region.local_addr, region.executable, region.writeable);
+		}
+
 	public:
 
 		/**
@@ -220,7 +249,8 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 
 					enum { USE_LOCAL_ADDR = true };
 					dst_rm.attach(ds, curr->size, curr->offset, USE_LOCAL_ADDR,
-					              curr->local_addr, curr->executable);
+					              curr->local_addr, curr->executable,
+					              curr->writeable);
 				};
 				_ds_registry.apply(curr->ds, lambda);
 			};
@@ -235,25 +265,25 @@ class Noux::Region_map_component : public Rpc_object<Region_map>,
 		                  size_t size = 0, off_t offset = 0,
 		                  bool use_local_addr = false,
 		                  Local_addr local_addr = (addr_t)0,
-		                  bool executable = false) override
+		                  bool executable = false,
+		                  bool writeable = true) override
 		{
 			/*
 			 * Region map subtracts offset from size if size is 0
 			 */
 			if (size == 0) size = Dataspace_client(ds).size() - offset;
 
-			for (;;) {
-				try {
-					local_addr = _rm.attach(ds, size, offset, use_local_addr,
-					                        local_addr, executable);
-					break;
-				}
-				catch (Out_of_ram)  { _pd.upgrade_ram(8*1024); }
-				catch (Out_of_caps) { _pd.upgrade_caps(2); }
-			}
+			/* copy-on-write dataspaces are attached via a managed dataspace */
+			Dataspace_capability core_ds = ds;
+			_ds_registry.apply(ds, [&] (Dataspace_info *info) {
+				if (info) core_ds = info->attach_cap(executable); });
+
+			local_addr = _core_attach(core_ds, size, offset, use_local_addr,
+			                          local_addr, executable, writeable);
 
 			Region * region = new (_alloc) Region(*this, ds, size, offset,
-			                                      local_addr, executable);
+			                                      local_addr, executable,
+			                                      writeable);
 
 			/* register region as user of RAM dataspaces */
 			auto lambda = [&] (Dataspace_info *info)
@@ -418,4 +448,10 @@ inline void Noux::Region_map_component::Region::dissolve(Dataspace_info &ds)
 }
 
 
+inline void Noux::Region_map_component::Region::remap(Dataspace_info &ds)
+{
+	rm._remap(*this, ds);
+}
+
+
 #endif /* _NOUX__REGION_MAP_COMPONENT_H_ */
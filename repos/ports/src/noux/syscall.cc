@@ -82,8 +82,20 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 			{
 				Shared_pointer<Io_channel> io = _lookup_channel(_sysio.read_in.fd);
 
-				if (!io->nonblocking())
+				Io_channel::Read_request request(_sysio);
+
+				if (!io->nonblocking()) {
+					io->announce_read(request);
 					_block_for_io_channel(io, true, false, false);
+					io->withdraw_read(request);
+				}
+
+				/* data was delivered directly while blocking */
+				if (request.count) {
+					_sysio.read_out.count = request.count;
+					result = true;
+					break;
+				}
 
 				if (io->check_unblock(true, false, false))
 					result = io->read(_sysio);
@@ -533,6 +545,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 					child = new (_heap) Child(_child_policy.name(),
 					                          _verbose,
 					                          _user_info,
+					                          _pipe_buffer_size,
 					                          this,
 					                          _kill_broadcaster,
 					                          _timeout_scheduler,
@@ -611,7 +624,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_PIPE:
 			{
-				Shared_pointer<Pipe>       pipe       (new (_heap) Pipe,                                    _heap);
+				Shared_pointer<Pipe>       pipe       (new (_heap) Pipe(_heap, _pipe_buffer_size),          _heap);
 				Shared_pointer<Io_channel> pipe_sink  (new (_heap) Pipe_sink_io_channel  (pipe, _env.ep()), _heap);
 				Shared_pointer<Io_channel> pipe_source(new (_heap) Pipe_source_io_channel(pipe, _env.ep()), _heap);
 